@@ -0,0 +1,581 @@
+//BlockHeader:     :  ,        .
+//FreeNode :  -   ,     .
+//MemoryManager :     ,      -    (, ).
+//BestFit, WorstFit :   -   MemoryManager,     .
+//allocate(size_t size) :      ,       .     O(log n),     .
+//deallocate(void* address) :     ,     .         O(log n).
+//deallocate(void* address, size_t size) :    ,    (  ).
+//allocateBatch(size_t size, size_t count, void** out) :              .
+//deallocateBatch(void** ptrs, size_t count, size_t size) :  :      ,       .
+//forEachFreeBlock(Visit visit) :       Stats::snapshot,      ALLOCATOR_STATS.
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include "AllocatorStats.h"
+
+namespace RedBlack {
+
+//    (    ,   )
+struct BlockHeader {
+    size_t size;           //     ,   -  ""
+    BlockHeader* prevPhys; //    (nullptr    )
+};
+
+//  - ,     
+struct FreeNode : BlockHeader {
+    FreeNode* left;   //  
+    FreeNode* right;  //  
+    FreeNode* parent; // 
+    bool red;         //  
+};
+
+//  :      ( ,   ).
+//    ,          .
+
+//    -     O(log n)
+struct BestFit {
+    template <class Manager>
+    FreeNode* find(Manager& manager, size_t needed, Stats::Probe& probe) {
+        return manager.findBestFit(needed, probe);
+    }
+};
+
+//   -    
+struct WorstFit {
+    template <class Manager>
+    FreeNode* find(Manager& manager, size_t needed, Stats::Probe& probe) {
+        FreeNode* node = manager.maximum(probe);
+        return Manager::sizeOf(node) >= needed ? node : &manager.nil;
+    }
+};
+
+//         
+template <class Policy = BestFit>
+class MemoryManager {
+public:
+    static const size_t kAlignment = 16; //     
+
+private:
+    friend Policy;
+
+    static const size_t kFreeFlag = 1;    //      size
+    static const size_t kHeaderSize = (sizeof(BlockHeader) + kAlignment - 1) & ~(kAlignment - 1);
+    static const size_t kMinBlockSize = (sizeof(FreeNode) + kAlignment - 1) & ~(kAlignment - 1);
+
+    char* memoryPool;   //     
+    char* poolBegin;    //   
+    char* poolEnd;      //  
+    size_t memorySize;  //   
+    FreeNode nil;       //    (    )
+    FreeNode* root;     //    
+    size_t freeCount;   //     
+    size_t freeTotal;   //    
+    Policy policy;      //  
+    ALLOCATOR_STAT(Stats::Counters stats;) //  
+
+public:
+    MemoryManager(size_t size) : memorySize(size), root(&nil), freeCount(0), freeTotal(0) {
+        //    
+        memoryPool = new char[size + kAlignment];
+        poolBegin = alignUp(memoryPool);
+        poolEnd = poolBegin + (size & ~(kAlignment - 1));
+
+        nil.size = 0;
+        nil.prevPhys = nullptr;
+        nil.left = nil.right = nil.parent = &nil;
+        nil.red = false;
+
+        //   -   
+        if (static_cast<size_t>(poolEnd - poolBegin) >= kMinBlockSize) {
+            FreeNode* initialBlock = reinterpret_cast<FreeNode*>(poolBegin);
+            initialBlock->size = static_cast<size_t>(poolEnd - poolBegin) | kFreeFlag;
+            initialBlock->prevPhys = nullptr;
+            insertNode(initialBlock);
+        }
+    }
+
+    ~MemoryManager() {
+        //     
+        delete[] memoryPool;
+    }
+
+    MemoryManager(const MemoryManager&) = delete;
+    MemoryManager& operator=(const MemoryManager&) = delete;
+
+    //       (   )
+    void* allocate(size_t size) {
+        if (size == 0 || size > memorySize)
+            return nullptr;
+        size_t needed = blockSizeFor(size);
+
+        Stats::Probe probe;
+        FreeNode* block = policy.find(*this, needed, probe);
+        if (block == &nil) {
+            ALLOCATOR_STAT(stats.onAllocate(size, 0, probe));
+            return nullptr; //     ,  nullptr
+        }
+
+        eraseNode(block);
+        size_t blockSize = sizeOf(block);
+
+        //  ,       
+        if (blockSize - needed >= kMinBlockSize) {
+            FreeNode* rest = reinterpret_cast<FreeNode*>(reinterpret_cast<char*>(block) + needed);
+            rest->size = (blockSize - needed) | kFreeFlag;
+            rest->prevPhys = block;
+            BlockHeader* after = nextPhys(rest);
+            if (after) after->prevPhys = rest;
+            insertNode(rest);
+            blockSize = needed;
+            ALLOCATOR_STAT(stats.onSplit());
+        }
+
+        block->size = blockSize; //    
+        ALLOCATOR_STAT(stats.onAllocate(size, blockSize, probe));
+        return reinterpret_cast<char*>(block) + kHeaderSize;
+    }
+
+    //      (    )
+    void deallocate(void* address) {
+        if (!address)
+            return;
+        BlockHeader* block = reinterpret_cast<BlockHeader*>(reinterpret_cast<char*>(address) - kHeaderSize);
+        ALLOCATOR_STAT(stats.onDeallocate(sizeOf(block)));
+        freeRange(block, sizeOf(block));
+    }
+
+    void deallocate(void* address, size_t size) {
+        (void)size;
+        deallocate(address);
+    }
+
+    //  count   size  out.       
+    //  ( -   ),       ,  ;
+    //      .    .
+    size_t allocateBatch(size_t size, size_t count, void** out) {
+        if (size == 0 || size > memorySize)
+            return 0;
+        size_t needed = blockSizeFor(size);
+
+        size_t done = 0;
+        while (done < count) {
+            Stats::Probe probe;
+            FreeNode* block = policy.find(*this, needed * std::min(count - done, memorySize / needed), probe);
+            if (block == &nil)
+                block = policy.find(*this, needed, probe);
+            if (block == &nil) {
+                ALLOCATOR_STAT(stats.onAllocate(size, 0, probe));
+                break;
+            }
+            eraseNode(block);
+
+            //       
+            size_t blockSize = sizeOf(block);
+            size_t take = std::min(count - done, blockSize / needed);
+            size_t rest = blockSize - take * needed;
+            BlockHeader* prev = block->prevPhys;
+            char* chunk = reinterpret_cast<char*>(block);
+            for (size_t i = 0; i < take; ++i) {
+                BlockHeader* header = reinterpret_cast<BlockHeader*>(chunk);
+                header->size = i + 1 == take && rest < kMinBlockSize ? needed + rest : needed;
+                header->prevPhys = prev;
+                out[done++] = chunk + kHeaderSize;
+                prev = header;
+                chunk += header->size;
+                ALLOCATOR_STAT(stats.onAllocate(size, header->size, i == 0 ? probe : Stats::Probe()));
+            }
+            if (rest >= kMinBlockSize) {
+                FreeNode* restBlock = reinterpret_cast<FreeNode*>(chunk);
+                restBlock->size = rest | kFreeFlag;
+                restBlock->prevPhys = prev;
+                prev = restBlock;
+                insertNode(restBlock);
+                ALLOCATOR_STAT(stats.onSplit());
+            }
+            BlockHeader* after = nextPhys(prev);
+            if (after) after->prevPhys = prev;
+        }
+        return done;
+    }
+
+    //  count   size.     ( ptrs
+    // ),        ,  
+    //          .
+    void deallocateBatch(void** ptrs, size_t count, size_t size) {
+        (void)size;
+        std::sort(ptrs, ptrs + count, [](void* a, void* b) { return std::less<void*>()(a, b); });
+        for (size_t i = 0; i < count; ) {
+            if (!ptrs[i]) {
+                ++i;
+                continue;
+            }
+            BlockHeader* block = reinterpret_cast<BlockHeader*>(reinterpret_cast<char*>(ptrs[i++]) - kHeaderSize);
+            size_t blockSize = sizeOf(block);
+            ALLOCATOR_STAT(stats.onDeallocate(blockSize));
+            while (i < count && reinterpret_cast<char*>(ptrs[i]) - kHeaderSize == reinterpret_cast<char*>(block) + blockSize) {
+                size_t nextSize = sizeOf(reinterpret_cast<BlockHeader*>(reinterpret_cast<char*>(ptrs[i++]) - kHeaderSize));
+                blockSize += nextSize;
+                ALLOCATOR_STAT(stats.onDeallocate(nextSize); stats.onMerge());
+            }
+            freeRange(block, blockSize);
+        }
+    }
+
+    //   
+    size_t freeBlockCount() const { return freeCount; }
+
+    //     (  )
+    size_t freeBytes() const { return freeTotal; }
+
+    //     -    
+    size_t largestFreeBlock() const {
+        Stats::Probe probe;
+        return sizeOf(maximum(probe));
+    }
+
+    //      , visit(size)  
+    template <class Visit>
+    void forEachFreeBlock(Visit visit) const {
+        visitSubtree(root, visit);
+    }
+
+#ifdef ALLOCATOR_STATS
+    const Stats::Counters& counters() const { return stats; }
+#endif
+
+    //   -    
+    bool isConsistent() const {
+        if (root->red || nil.red)
+            return false;
+        size_t nodes = 0;
+        if (blackHeight(root, nodes) < 0 || nodes != freeCount)
+            return false;
+
+        //     
+        size_t freeBlocks = 0;
+        const BlockHeader* prev = nullptr;
+        bool prevFree = false;
+        for (const char* p = poolBegin; p < poolEnd; ) {
+            const BlockHeader* block = reinterpret_cast<const BlockHeader*>(p);
+            size_t blockSize = sizeOf(block);
+            if (blockSize < kMinBlockSize || blockSize % kAlignment != 0 || block->prevPhys != prev)
+                return false;
+            if (isFree(block)) {
+                if (prevFree)
+                    return false; //      
+                ++freeBlocks;
+            }
+            prevFree = isFree(block);
+            prev = block;
+            p += blockSize;
+        }
+        return freeBlocks == freeCount;
+    }
+
+private:
+    static char* alignUp(char* p) {
+        uintptr_t value = reinterpret_cast<uintptr_t>(p);
+        return reinterpret_cast<char*>((value + kAlignment - 1) & ~(uintptr_t)(kAlignment - 1));
+    }
+
+    static size_t blockSizeFor(size_t size) {
+        size_t total = (size + kHeaderSize + kAlignment - 1) & ~(kAlignment - 1);
+        return total < kMinBlockSize ? kMinBlockSize : total;
+    }
+
+    static size_t sizeOf(const BlockHeader* block) { return block->size & ~kFreeFlag; }
+    static bool isFree(const BlockHeader* block) { return (block->size & kFreeFlag) != 0; }
+
+    BlockHeader* nextPhys(BlockHeader* block) const {
+        char* next = reinterpret_cast<char*>(block) + sizeOf(block);
+        return next < poolEnd ? reinterpret_cast<BlockHeader*>(next) : nullptr;
+    }
+
+    //   [block, block + blockSize)   :   
+    //       
+    void freeRange(BlockHeader* block, size_t blockSize) {
+        block->size = blockSize; //      
+
+        //     
+        BlockHeader* next = nextPhys(block);
+        if (next && isFree(next)) {
+            eraseNode(static_cast<FreeNode*>(next));
+            blockSize += sizeOf(next);
+            ALLOCATOR_STAT(stats.onMerge());
+        }
+
+        //     
+        BlockHeader* prev = block->prevPhys;
+        if (prev && isFree(prev)) {
+            eraseNode(static_cast<FreeNode*>(prev));
+            blockSize += sizeOf(prev);
+            ALLOCATOR_STAT(stats.onMerge());
+            block = prev;
+        }
+
+        block->size = blockSize | kFreeFlag;
+        BlockHeader* after = nextPhys(block);
+        if (after) after->prevPhys = block;
+        insertNode(static_cast<FreeNode*>(block));
+    }
+
+    //   :  ,   -  
+    static bool less(const FreeNode* a, const FreeNode* b) {
+        size_t sa = sizeOf(a), sb = sizeOf(b);
+        return sa < sb || (sa == sb && a < b);
+    }
+
+    //      needed (   -   )
+    FreeNode* findBestFit(size_t needed, Stats::Probe& probe) {
+        FreeNode* best = &nil;
+        FreeNode* node = root;
+        while (node != &nil) {
+            probe.step();
+            if (sizeOf(node) >= needed) {
+                best = node;
+                node = node->left;
+            }
+            else {
+                node = node->right;
+            }
+        }
+        return best;
+    }
+
+    //    -   (    ,   0)
+    FreeNode* maximum(Stats::Probe& probe) const {
+        FreeNode* node = root;
+        if (node == &nil)
+            return node;
+        while (node->right != &nil) {
+            probe.step();
+            node = node->right;
+        }
+        return node;
+    }
+
+    template <class Visit>
+    void visitSubtree(const FreeNode* node, Visit& visit) const {
+        if (node == &nil)
+            return;
+        visitSubtree(node->left, visit);
+        visit(sizeOf(node));
+        visitSubtree(node->right, visit);
+    }
+
+    FreeNode* minimum(FreeNode* node) {
+        while (node->left != &nil)
+            node = node->left;
+        return node;
+    }
+
+    void rotateLeft(FreeNode* x) {
+        FreeNode* y = x->right;
+        x->right = y->left;
+        if (y->left != &nil) y->left->parent = x;
+        y->parent = x->parent;
+        if (x->parent == &nil) root = y;
+        else if (x == x->parent->left) x->parent->left = y;
+        else x->parent->right = y;
+        y->left = x;
+        x->parent = y;
+    }
+
+    void rotateRight(FreeNode* x) {
+        FreeNode* y = x->left;
+        x->left = y->right;
+        if (y->right != &nil) y->right->parent = x;
+        y->parent = x->parent;
+        if (x->parent == &nil) root = y;
+        else if (x == x->parent->right) x->parent->right = y;
+        else x->parent->left = y;
+        y->right = x;
+        x->parent = y;
+    }
+
+    //     
+    void insertNode(FreeNode* z) {
+        FreeNode* parent = &nil;
+        FreeNode* node = root;
+        while (node != &nil) {
+            parent = node;
+            node = less(z, node) ? node->left : node->right;
+        }
+        z->parent = parent;
+        if (parent == &nil) root = z;
+        else if (less(z, parent)) parent->left = z;
+        else parent->right = z;
+        z->left = z->right = &nil;
+        z->red = true;
+        insertFixup(z);
+        ++freeCount;
+        freeTotal += sizeOf(z);
+    }
+
+    void insertFixup(FreeNode* z) {
+        while (z->parent->red) {
+            if (z->parent == z->parent->parent->left) {
+                FreeNode* uncle = z->parent->parent->right;
+                if (uncle->red) {
+                    z->parent->red = false;
+                    uncle->red = false;
+                    z->parent->parent->red = true;
+                    z = z->parent->parent;
+                }
+                else {
+                    if (z == z->parent->right) {
+                        z = z->parent;
+                        rotateLeft(z);
+                    }
+                    z->parent->red = false;
+                    z->parent->parent->red = true;
+                    rotateRight(z->parent->parent);
+                }
+            }
+            else {
+                FreeNode* uncle = z->parent->parent->left;
+                if (uncle->red) {
+                    z->parent->red = false;
+                    uncle->red = false;
+                    z->parent->parent->red = true;
+                    z = z->parent->parent;
+                }
+                else {
+                    if (z == z->parent->left) {
+                        z = z->parent;
+                        rotateRight(z);
+                    }
+                    z->parent->red = false;
+                    z->parent->parent->red = true;
+                    rotateLeft(z->parent->parent);
+                }
+            }
+        }
+        root->red = false;
+    }
+
+    void transplant(FreeNode* u, FreeNode* v) {
+        if (u->parent == &nil) root = v;
+        else if (u == u->parent->left) u->parent->left = v;
+        else u->parent->right = v;
+        v->parent = u->parent;
+    }
+
+    //     
+    void eraseNode(FreeNode* z) {
+        FreeNode* y = z;
+        bool yWasRed = y->red;
+        FreeNode* x;
+        if (z->left == &nil) {
+            x = z->right;
+            transplant(z, z->right);
+        }
+        else if (z->right == &nil) {
+            x = z->left;
+            transplant(z, z->left);
+        }
+        else {
+            y = minimum(z->right);
+            yWasRed = y->red;
+            x = y->right;
+            if (y->parent == z) {
+                x->parent = y;
+            }
+            else {
+                transplant(y, y->right);
+                y->right = z->right;
+                y->right->parent = y;
+            }
+            transplant(z, y);
+            y->left = z->left;
+            y->left->parent = y;
+            y->red = z->red;
+        }
+        if (!yWasRed)
+            eraseFixup(x);
+        --freeCount;
+        freeTotal -= sizeOf(z);
+    }
+
+    void eraseFixup(FreeNode* x) {
+        while (x != root && !x->red) {
+            if (x == x->parent->left) {
+                FreeNode* w = x->parent->right;
+                if (w->red) {
+                    w->red = false;
+                    x->parent->red = true;
+                    rotateLeft(x->parent);
+                    w = x->parent->right;
+                }
+                if (!w->left->red && !w->right->red) {
+                    w->red = true;
+                    x = x->parent;
+                }
+                else {
+                    if (!w->right->red) {
+                        w->left->red = false;
+                        w->red = true;
+                        rotateRight(w);
+                        w = x->parent->right;
+                    }
+                    w->red = x->parent->red;
+                    x->parent->red = false;
+                    w->right->red = false;
+                    rotateLeft(x->parent);
+                    x = root;
+                }
+            }
+            else {
+                FreeNode* w = x->parent->left;
+                if (w->red) {
+                    w->red = false;
+                    x->parent->red = true;
+                    rotateRight(x->parent);
+                    w = x->parent->left;
+                }
+                if (!w->right->red && !w->left->red) {
+                    w->red = true;
+                    x = x->parent;
+                }
+                else {
+                    if (!w->left->red) {
+                        w->right->red = false;
+                        w->red = true;
+                        rotateLeft(w);
+                        w = x->parent->left;
+                    }
+                    w->red = x->parent->red;
+                    x->parent->red = false;
+                    w->left->red = false;
+                    rotateRight(x->parent);
+                    x = root;
+                }
+            }
+        }
+        x->red = false;
+    }
+
+    // ׸    -1,    
+    int blackHeight(const FreeNode* node, size_t& nodes) const {
+        if (node == &nil)
+            return 1;
+        ++nodes;
+        if (!isFree(node))
+            return -1;
+        if (node->red && (node->left->red || node->right->red))
+            return -1;
+        if (node->left != &nil && (node->left->parent != node || !less(node->left, node)))
+            return -1;
+        if (node->right != &nil && (node->right->parent != node || !less(node, node->right)))
+            return -1;
+        int left = blackHeight(node->left, nodes);
+        int right = blackHeight(node->right, nodes);
+        if (left < 0 || right < 0 || left != right)
+            return -1;
+        return left + (node->red ? 0 : 1);
+    }
+};
+
+} // namespace RedBlack
@@ -0,0 +1,98 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cassert>
+#include <algorithm>
+#include "RedBlackManager.h"
+
+using namespace RedBlack;
+
+//  :       
+void runSelfTest() {
+    MemoryManager<> manager(1024 * 1024);
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<size_t> sizeDist(1, 2000);
+    std::vector<std::pair<unsigned char*, size_t>> live;
+
+    for (int step = 0; step < 20000; ++step) {
+        if (live.empty() || rng() % 3 != 0) {
+            size_t size = sizeDist(rng);
+            unsigned char* ptr = static_cast<unsigned char*>(manager.allocate(size));
+            if (ptr) {
+                assert(reinterpret_cast<uintptr_t>(ptr) % 16 == 0);
+                std::fill(ptr, ptr + size, static_cast<unsigned char>(size));
+                live.push_back({ ptr, size });
+            }
+        }
+        else {
+            size_t index = rng() % live.size();
+            auto entry = live[index];
+            for (size_t i = 0; i < entry.second; ++i)
+                assert(entry.first[i] == static_cast<unsigned char>(entry.second));
+            manager.deallocate(entry.first, entry.second);
+            live[index] = live.back();
+            live.pop_back();
+        }
+        if (step % 1000 == 0)
+            assert(manager.isConsistent());
+    }
+
+    for (auto& entry : live)
+        manager.deallocate(entry.first, entry.second);
+    assert(manager.isConsistent());
+    assert(manager.freeBlockCount() == 1); //      
+
+    std::cout << "self-test passed" << std::endl;
+}
+
+//         
+void runBenchmark(size_t fragments) {
+    MemoryManager<> manager(fragments * 1024 + 1024 * 1024);
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<size_t> sizeDist(16, 256);
+
+    //  :    
+    std::vector<void*> blocks;
+    for (size_t i = 0; i < fragments * 2; ++i)
+        blocks.push_back(manager.allocate(sizeDist(rng)));
+    for (size_t i = 0; i < blocks.size(); i += 2)
+        manager.deallocate(blocks[i], 0);
+
+    const int operations = 200000;
+    std::vector<void*> window(64, nullptr);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < operations; ++i) {
+        void*& slot = window[i % window.size()];
+        manager.deallocate(slot, 0);
+        slot = manager.allocate(sizeDist(rng));
+    }
+    auto finish = std::chrono::steady_clock::now();
+
+    double ns = std::chrono::duration<double, std::nano>(finish - start).count() / operations;
+    std::cout << "fragments=" << manager.freeBlockCount()
+              << " ns/op(alloc+free)=" << ns
+              << " Mops/s=" << 1000.0 / ns << std::endl;
+}
+
+//  
+int main() {
+    //       1MB
+    MemoryManager<> manager(1024 * 1024);
+
+    //  
+    void* ptr1 = manager.allocate(100);
+    void* ptr2 = manager.allocate(200);
+    void* ptr3 = manager.allocate(50);
+
+    //  
+    manager.deallocate(ptr1, 100);
+    manager.deallocate(ptr2, 200);
+    manager.deallocate(ptr3, 50);
+
+    runSelfTest();
+    for (size_t fragments : { 1000, 10000, 100000 })
+        runBenchmark(fragments);
+
+    return 0;
+}
@@ -0,0 +1,113 @@
+//Adapters::allocate(Manager& manager, size_t size, size_t alignment) :       .  Manager::kAlignment    ,   -         .
+//Adapters::deallocate(Manager& manager, void* address, size_t alignment) :  ,  Adapters::allocate,  .
+//Adapters::ManagerResource<Manager> : std::pmr::memory_resource     -   pmr-.
+//Adapters::ManagerAllocator<T, Manager> :  Allocator        .
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <memory_resource>
+#include <utility>
+
+namespace Adapters {
+
+//   ,    :   -  
+// (  ,   CachedAllocator).
+
+template <class Manager>
+void* allocate(Manager& manager, size_t size, size_t alignment) {
+    if (alignment <= Manager::kAlignment)
+        return manager.allocate(size ? size : 1);
+    if (size > SIZE_MAX - alignment)
+        return nullptr; //      size_t
+    char* raw = static_cast<char*>(manager.allocate(size + alignment));
+    if (!raw)
+        return nullptr;
+    //    kAlignment..alignment   :    ,
+    //     
+    uintptr_t aligned = (reinterpret_cast<uintptr_t>(raw) + sizeof(void*) + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+    reinterpret_cast<void**>(aligned)[-1] = raw;
+    return reinterpret_cast<void*>(aligned);
+}
+
+//   :     
+template <class Manager>
+void deallocate(Manager& manager, void* address, size_t alignment) {
+    if (!address)
+        return;
+    if (alignment <= Manager::kAlignment)
+        manager.deallocate(address);
+    else
+        manager.deallocate(static_cast<void**>(address)[-1]);
+}
+
+//   ;     ( ,  )
+template <class Manager>
+class ManagerResource : public std::pmr::memory_resource {
+public:
+    template <class... Args>
+    explicit ManagerResource(Args&&... args) : manager(std::forward<Args>(args)...) {}
+
+    Manager& underlying() { return manager; }
+    const Manager& underlying() const { return manager; }
+
+private:
+    Manager manager;
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        void* address = Adapters::allocate(manager, bytes, alignment);
+        if (!address)
+            throw std::bad_alloc();
+        return address;
+    }
+
+    void do_deallocate(void* address, size_t bytes, size_t alignment) override {
+        (void)bytes;
+        Adapters::deallocate(manager, address, alignment);
+    }
+
+    //       ,    
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+//    :   ( )    
+template <class T, class Manager>
+class ManagerAllocator {
+public:
+    typedef T value_type;
+
+    explicit ManagerAllocator(Manager& manager) noexcept : manager(&manager) {}
+
+    template <class U>
+    ManagerAllocator(const ManagerAllocator<U, Manager>& other) noexcept : manager(other.manager) {}
+
+    T* allocate(size_t count) {
+        if (count > static_cast<size_t>(-1) / sizeof(T))
+            throw std::bad_array_new_length();
+        void* address = Adapters::allocate(*manager, count * sizeof(T), alignof(T));
+        if (!address)
+            throw std::bad_alloc();
+        return static_cast<T*>(address);
+    }
+
+    void deallocate(T* address, size_t count) noexcept {
+        (void)count;
+        Adapters::deallocate(*manager, address, alignof(T));
+    }
+
+    template <class U>
+    bool operator==(const ManagerAllocator<U, Manager>& other) const noexcept { return manager == other.manager; }
+
+    template <class U>
+    bool operator!=(const ManagerAllocator<U, Manager>& other) const noexcept { return manager != other.manager; }
+
+private:
+    template <class U, class M>
+    friend class ManagerAllocator;
+
+    Manager* manager;
+};
+
+} // namespace Adapters
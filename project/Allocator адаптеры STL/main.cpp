@@ -0,0 +1,107 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <map>
+#include <list>
+#include <string>
+#include <memory>
+#include <chrono>
+#include <cassert>
+#include <cstdint>
+#include <memory_resource>
+#include "ManagerAdapters.h"
+#include "BuddyManager.h"
+#include "BoundaryTagManager.h"
+#include "SortedListManager.h"
+#include "RedBlackManager.h"
+
+//   Person  project/Source.cpp:   
+struct Record {
+    unsigned age;
+    std::pmr::string name;
+
+    Record(unsigned age, std::string_view name, std::pmr::memory_resource* resource) : age(age), name(name, resource) {}
+};
+
+//    ,   
+struct alignas(64) CacheLine {
+    char data[64];
+};
+
+//   :  ,   ,  ;    resource
+void runContainers(std::pmr::memory_resource* resource, int records) {
+    std::pmr::vector<Record> people(resource);
+    std::pmr::map<unsigned, std::pmr::vector<const Record*>> byAge(resource);
+    std::pmr::list<std::pmr::string> names(resource);
+
+    for (int i = 0; i < records; ++i) {
+        unsigned age = static_cast<unsigned>(i * 7 % 100);
+        people.emplace_back(age, "person with a fairly long name " + std::to_string(i), resource);
+    }
+    for (const Record& person : people) {
+        byAge[person.age].push_back(&person);
+        names.emplace_back(person.name); //      (uses-allocator)
+    }
+    names.sort();
+    assert(byAge.size() == 100 && names.size() == people.size());
+}
+
+template <class Resource>
+void report(const char* name, Resource& resource, int records, int rounds) {
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; ++round)
+        runContainers(&resource, records);
+    auto finish = std::chrono::steady_clock::now();
+    std::cout << std::left << std::setw(15) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(12) << std::chrono::duration<double, std::milli>(finish - start).count() / rounds << std::endl;
+}
+
+//  
+int main() {
+    //        
+    BoundaryTags::MemoryManager<> manager(1024 * 1024);
+    typedef Adapters::ManagerAllocator<int, BoundaryTags::MemoryManager<>> IntAllocator;
+    std::vector<int, IntAllocator> numbers{ IntAllocator(manager) };
+    for (int i = 0; i < 1000; ++i)
+        numbers.push_back(i);
+
+    typedef std::pair<const int, double> Entry;
+    std::map<int, double, std::less<int>, Adapters::ManagerAllocator<Entry, BoundaryTags::MemoryManager<>>> squares{ IntAllocator(manager) };
+    for (int i = 0; i < 100; ++i)
+        squares[i] = i * 1.0 * i;
+
+    //   16   
+    std::vector<CacheLine, Adapters::ManagerAllocator<CacheLine, BoundaryTags::MemoryManager<>>> lines{ IntAllocator(manager) };
+    lines.resize(10);
+    assert(reinterpret_cast<uintptr_t>(lines.data()) % alignof(CacheLine) == 0);
+    assert(Adapters::allocate(manager, SIZE_MAX - 8, alignof(CacheLine)) == nullptr);
+
+    //        16,   malloc
+    void* raw = manager.allocate(24);
+    assert(reinterpret_cast<uintptr_t>(raw) % 16 == 0);
+    manager.deallocate(raw);
+
+    //    pmr-      
+    const int records = 20000;
+    const int rounds = 5;
+    const size_t poolSize = size_t(256) << 20;
+    std::cout << std::left << std::setw(15) << "resource" << std::right << std::setw(12) << "ms/round" << std::endl;
+    report("default heap", *std::pmr::new_delete_resource(), records, rounds);
+    {
+        Adapters::ManagerResource<Buddy::MemoryManager<>> resource(poolSize);
+        report("buddy", resource, records, rounds);
+    }
+    {
+        Adapters::ManagerResource<BoundaryTags::MemoryManager<>> resource(poolSize);
+        report("boundary-tags", resource, records, rounds);
+    }
+    {
+        Adapters::ManagerResource<SortedList::MemoryManager<>> resource(poolSize);
+        report("sorted-list", resource, records, rounds);
+    }
+    {
+        Adapters::ManagerResource<RedBlack::MemoryManager<>> resource(poolSize);
+        report("red-black", resource, records, rounds);
+    }
+    return 0;
+}
@@ -0,0 +1,218 @@
+//MonotonicArena<Manager> :      :      ,    (  -   ),    .
+//allocate(size_t size) :    .       ;   ,    .
+//allocate(size_t size, size_t alignment) :      kAlignment.
+//deallocate(void* address) :    -      (       ).
+//reset() :     O(1).       .
+//checkpoint() / rollback(const Checkpoint& mark) :      :      .
+//MonotonicArena::Scope :      -         .
+//trim() :   ,   .
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+template <class Manager>
+class MonotonicArena {
+public:
+    static const size_t kAlignment = 16; //      
+
+private:
+    //     ;     
+    struct Chunk {
+        Chunk* next;  //   ( reset   -    )
+        char* end;    //  
+        size_t size;  //  ,     
+    };
+
+    static const size_t kHeaderSize = (sizeof(Chunk) + kAlignment - 1) & ~(kAlignment - 1);
+    static const size_t kFirstChunk = 64 * 1024;      //  
+    static const size_t kMaxChunk = 4 * 1024 * 1024;  //     
+
+    Manager manager;   // ,    
+    Chunk* first;      //  
+    Chunk* current;    // ,    
+    char* top;         // :       
+    char* limit;       //   
+    size_t nextChunk;  //    
+    size_t chunkBytes; //    
+
+public:
+    //   
+    struct Checkpoint {
+        Chunk* chunk;
+        char* top;
+    };
+
+    //    ,   
+    class Scope {
+    public:
+        explicit Scope(MonotonicArena& arena) : arena(arena), mark(arena.checkpoint()) {}
+        ~Scope() { arena.rollback(mark); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        MonotonicArena& arena;
+        Checkpoint mark;
+    };
+
+    //     ( ,  )
+    template <class... Args>
+    explicit MonotonicArena(Args&&... args)
+        : manager(std::forward<Args>(args)...), first(nullptr), current(nullptr), top(nullptr), limit(nullptr),
+          nextChunk(kFirstChunk), chunkBytes(0) {}
+
+    ~MonotonicArena() {
+        //          
+    }
+
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    //    .       kAlignment, 
+    // size <= limit - top ,     :   - 
+    //     (size - 1      )
+    void* allocate(size_t size) {
+        if (size - 1 < static_cast<size_t>(limit - top)) {
+            void* address = top;
+            top += (size + kAlignment - 1) & ~(kAlignment - 1);
+            return address;
+        }
+        return allocateSlow(size, kAlignment);
+    }
+
+    void* allocate(size_t size, size_t alignment) {
+        if (alignment <= kAlignment)
+            return allocate(size);
+        // aligned < top -   alignment     
+        uintptr_t aligned = (reinterpret_cast<uintptr_t>(top) + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+        uintptr_t end = reinterpret_cast<uintptr_t>(limit);
+        if (top && aligned >= reinterpret_cast<uintptr_t>(top) && aligned < end && size - 1 < end - aligned) {
+            top = reinterpret_cast<char*>(aligned) + ((size + kAlignment - 1) & ~(kAlignment - 1));
+            return reinterpret_cast<void*>(aligned);
+        }
+        return allocateSlow(size, alignment);
+    }
+
+    //    :    reset  
+    void deallocate(void* address) { (void)address; }
+    void deallocate(void* address, size_t size) { (void)address; (void)size; }
+
+    //   :      
+    void reset() {
+        current = first;
+        top = first ? reinterpret_cast<char*>(first) + kHeaderSize : nullptr;
+        limit = first ? first->end : nullptr;
+    }
+
+    Checkpoint checkpoint() const {
+        Checkpoint mark;
+        mark.chunk = current;
+        mark.top = top;
+        return mark;
+    }
+
+    //   ; ,   ,  
+    void rollback(const Checkpoint& mark) {
+        if (!mark.chunk) {
+            reset();
+            return;
+        }
+        current = mark.chunk;
+        top = mark.top;
+        limit = current->end;
+    }
+
+    //     :   ,    
+    void trim() {
+        Chunk* chunk = current ? current->next : first;
+        if (current)
+            current->next = nullptr;
+        else
+            first = nullptr;
+        while (chunk) {
+            Chunk* next = chunk->next;
+            chunkBytes -= chunk->size;
+            manager.deallocate(chunk, chunk->size);
+            chunk = next;
+        }
+    }
+
+    // ,        (    )
+    size_t used() const {
+        size_t bytes = 0;
+        for (Chunk* chunk = first; chunk; chunk = chunk->next) {
+            if (chunk == current)
+                return bytes + static_cast<size_t>(top - reinterpret_cast<char*>(chunk) - kHeaderSize);
+            bytes += static_cast<size_t>(chunk->end - reinterpret_cast<char*>(chunk) - kHeaderSize);
+        }
+        return bytes;
+    }
+
+    // ,     
+    size_t capacity() const { return chunkBytes; }
+
+    //    (  )
+    Manager& underlying() { return manager; }
+    const Manager& underlying() const { return manager; }
+
+private:
+    //   :      ,   .
+    // ,          size_t, - .
+    void* allocateSlow(size_t size, size_t alignment) {
+        size_t rounded = (size + kAlignment - 1) & ~(kAlignment - 1);
+        if (size == 0 || rounded < size || alignment > SIZE_MAX - kHeaderSize || rounded > SIZE_MAX - kHeaderSize - alignment)
+            return nullptr;
+        Chunk* chunk = current ? current->next : first;
+        if (!chunk || !fits(chunk, rounded, alignment)) {
+            chunk = addChunk(rounded + alignment);
+            if (!chunk)
+                return nullptr;
+        }
+        current = chunk;
+        limit = chunk->end;
+        uintptr_t aligned = (reinterpret_cast<uintptr_t>(chunk) + kHeaderSize + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+        top = reinterpret_cast<char*>(aligned) + rounded;
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    //     ,      rounded  alignment
+    static bool fits(const Chunk* chunk, size_t rounded, size_t alignment) {
+        uintptr_t begin = reinterpret_cast<uintptr_t>(chunk) + kHeaderSize;
+        uintptr_t aligned = (begin + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+        uintptr_t end = reinterpret_cast<uintptr_t>(chunk->end);
+        return aligned >= begin && aligned <= end && rounded <= end - aligned;
+    }
+
+    //      :     ,
+    //          .  -  ,
+    //       .
+    Chunk* addChunk(size_t needed) {
+        size_t size = nextChunk;
+        while (size - kHeaderSize < needed) {
+            if (size > static_cast<size_t>(-1) / 2)
+                return nullptr;
+            size <<= 1;
+        }
+        void* raw = manager.allocate(size);
+        if (!raw)
+            return nullptr;
+        if (nextChunk < kMaxChunk)
+            nextChunk <<= 1;
+
+        Chunk* chunk = static_cast<Chunk*>(raw);
+        chunk->end = static_cast<char*>(raw) + size;
+        chunk->size = size;
+        if (current) {
+            chunk->next = current->next;
+            current->next = chunk;
+        }
+        else {
+            chunk->next = first;
+            first = chunk;
+        }
+        chunkBytes += size;
+        return chunk;
+    }
+};
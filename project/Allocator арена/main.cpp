@@ -0,0 +1,133 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <random>
+#include <cstring>
+#include <cassert>
+#include <cstdint>
+#include "MonotonicArena.h"
+#include "BuddyManager.h"
+#include "BoundaryTagManager.h"
+
+//   :   ,      
+struct Request {
+    std::vector<uint32_t> sizes;
+};
+
+//   50-500  16-512 ,    16KB
+std::vector<Request> makeRequests(size_t count) {
+    std::mt19937 rng(11);
+    std::vector<Request> requests(count);
+    for (Request& request : requests) {
+        size_t objects = 50 + rng() % 451;
+        request.sizes.resize(objects);
+        for (uint32_t& size : request.sizes)
+            size = rng() % 50 == 0 ? 1024 + rng() % (15 * 1024) : 16 + rng() % 497;
+    }
+    return requests;
+}
+
+// :       
+template <class Manager>
+size_t serve(Manager& manager, const Request& request, std::vector<void*>& pointers) {
+    size_t touched = 0;
+    for (size_t i = 0; i < request.sizes.size(); ++i) {
+        pointers[i] = manager.allocate(request.sizes[i]);
+        static_cast<char*>(pointers[i])[0] = static_cast<char>(i);
+        touched += static_cast<unsigned char>(static_cast<char*>(pointers[i])[0]);
+    }
+    for (size_t i = request.sizes.size(); i-- > 0; )
+        manager.deallocate(pointers[i], request.sizes[i]);
+    return touched;
+}
+
+// :   ,      reset
+template <class Manager>
+size_t serve(MonotonicArena<Manager>& arena, const Request& request, std::vector<void*>& pointers) {
+    size_t touched = 0;
+    for (size_t i = 0; i < request.sizes.size(); ++i) {
+        pointers[i] = arena.allocate(request.sizes[i]);
+        static_cast<char*>(pointers[i])[0] = static_cast<char>(i);
+        touched += static_cast<unsigned char>(static_cast<char*>(pointers[i])[0]);
+    }
+    arena.reset();
+    return touched;
+}
+
+//   ,       
+volatile size_t sink;
+
+//     ;        
+template <class Allocator>
+void runRequests(const char* name, const std::vector<Request>& requests, size_t poolSize) {
+    const int rounds = 20;
+    auto allocator = std::make_unique<Allocator>(poolSize);
+    std::vector<void*> pointers(512);
+    size_t objects = 0;
+    for (const Request& request : requests)
+        objects += request.sizes.size();
+
+    size_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; ++round) {
+        for (const Request& request : requests)
+            checksum += serve(*allocator, request, pointers);
+    }
+    auto finish = std::chrono::steady_clock::now();
+
+    double microseconds = std::chrono::duration<double, std::micro>(finish - start).count();
+    std::cout << std::left << std::setw(16) << name << std::right << std::fixed << std::setprecision(0)
+              << std::setw(14) << rounds * requests.size() / microseconds * 1e6
+              << std::setprecision(2) << std::setw(12) << microseconds * 1000 / (static_cast<double>(rounds) * objects) << std::endl;
+    sink = checksum;
+}
+
+//  
+int main() {
+    //       16MB
+    MonotonicArena<Buddy::MemoryManager<>> arena(16 * 1024 * 1024);
+
+    char* name = static_cast<char*>(arena.allocate(6));
+    std::memcpy(name, "Alice", 6);
+    double* values = static_cast<double*>(arena.allocate(100 * sizeof(double)));
+    values[99] = 1.0;
+
+    //          
+    size_t before = arena.used();
+    {
+        MonotonicArena<Buddy::MemoryManager<>>::Scope scope(arena);
+        for (int i = 0; i < 1000; ++i)
+            arena.allocate(200);
+        assert(arena.used() > before);
+    }
+    assert(arena.used() == before && std::strcmp(name, "Alice") == 0);
+
+    //   
+    void* line = arena.allocate(64, 64);
+    assert(reinterpret_cast<uintptr_t>(line) % 64 == 0);
+
+    //          size_t - ,     
+    assert(arena.allocate(SIZE_MAX - 20) == nullptr && arena.allocate(SIZE_MAX - 20, 64) == nullptr);
+    assert(arena.allocate(64, size_t(1) << 63) == nullptr);
+
+    //  :  ,     
+    size_t capacity = arena.capacity();
+    arena.reset();
+    assert(arena.used() == 0 && arena.capacity() == capacity);
+    assert(arena.allocate(SIZE_MAX - 20) == nullptr);
+    arena.trim();
+    assert(arena.capacity() > 0);
+
+    const size_t poolSize = size_t(64) << 20;
+    std::vector<Request> requests = makeRequests(2000);
+    std::cout << std::left << std::setw(16) << "allocator" << std::right << std::setw(14) << "requests/s"
+              << std::setw(12) << "ns/object" << std::endl;
+    runRequests<Buddy::MemoryManager<>>("buddy", requests, poolSize);
+    runRequests<BoundaryTags::MemoryManager<>>("boundary-tags", requests, poolSize);
+    runRequests<MonotonicArena<Buddy::MemoryManager<>>>("arena/buddy", requests, poolSize);
+    runRequests<MonotonicArena<BoundaryTags::MemoryManager<>>>("arena/tags", requests, poolSize);
+
+    return 0;
+}
@@ -0,0 +1,135 @@
+//Operation :   :       .
+//Trace :  -  ,       .
+//generateTrace(...) :  :   (  )    (LIFO, FIFO, ).
+//loadTrace(const std::string& path, Trace& trace) :    malloc/free   .
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <deque>
+#include <random>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+//   
+enum class SizeDistribution { Uniform, PowerLaw };
+
+//    
+enum class FreeOrder { Lifo, Fifo, Random };
+
+//  
+struct Operation {
+    bool allocate; // true - , false - 
+    uint32_t id;   //   (   )
+    uint32_t size; //   (  -    )
+};
+
+//  
+struct Trace {
+    std::string name;
+    std::vector<Operation> operations;
+    size_t blocks = 0; //    
+};
+
+//  :  liveBlocks  ,  steadyOperations 
+//        ,    .
+inline Trace generateTrace(SizeDistribution distribution, FreeOrder order,
+                           size_t liveBlocks, size_t steadyOperations, unsigned seed = 1) {
+    static const char* distributionNames[] = { "uniform", "power-law" };
+    static const char* orderNames[] = { "lifo", "fifo", "random" };
+
+    Trace trace;
+    trace.name = std::string(distributionNames[static_cast<int>(distribution)]) + "/" +
+                 orderNames[static_cast<int>(order)];
+
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<uint32_t> uniform(16, 1024);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<uint32_t> sizes;
+
+    //   (, alpha = 1.2):        64KB
+    auto nextSize = [&]() -> uint32_t {
+        if (distribution == SizeDistribution::Uniform)
+            return uniform(rng);
+        double value = 16.0 / std::pow(1.0 - unit(rng), 1.0 / 1.2);
+        return static_cast<uint32_t>(value < 65536.0 ? value : 65536.0);
+    };
+
+    std::deque<uint32_t> live;
+    auto allocate = [&]() {
+        uint32_t id = static_cast<uint32_t>(trace.blocks++);
+        uint32_t size = nextSize();
+        sizes.push_back(size);
+        trace.operations.push_back({ true, id, size });
+        live.push_back(id);
+    };
+    auto release = [&]() {
+        uint32_t id;
+        if (order == FreeOrder::Lifo) {
+            id = live.back();
+            live.pop_back();
+        }
+        else if (order == FreeOrder::Fifo) {
+            id = live.front();
+            live.pop_front();
+        }
+        else {
+            size_t index = rng() % live.size();
+            id = live[index];
+            live[index] = live.back();
+            live.pop_back();
+        }
+        trace.operations.push_back({ false, id, sizes[id] });
+    };
+
+    for (size_t i = 0; i < liveBlocks; ++i)
+        allocate();
+    for (size_t i = 0; i < steadyOperations; ++i) {
+        release();
+        allocate();
+    }
+    while (!live.empty())
+        release();
+    return trace;
+}
+
+//     .  :
+//   a <> <>   - 
+//   f <>            - 
+//   # ...               - 
+//  -  ,     malloc.      .
+inline bool loadTrace(const std::string& path, Trace& trace) {
+    std::ifstream input(path);
+    if (!input)
+        return false;
+
+    trace = Trace();
+    trace.name = path;
+    std::unordered_map<std::string, std::pair<uint32_t, uint32_t>> live; //  -> (, )
+    std::string line;
+    while (std::getline(input, line)) {
+        std::istringstream fields(line);
+        std::string kind, key;
+        if (!(fields >> kind >> key) || kind[0] == '#')
+            continue;
+        if (kind == "a") {
+            uint32_t size = 0;
+            if (!(fields >> size) || size == 0 || live.count(key))
+                continue;
+            uint32_t id = static_cast<uint32_t>(trace.blocks++);
+            live[key] = { id, size };
+            trace.operations.push_back({ true, id, size });
+        }
+        else if (kind == "f") {
+            auto it = live.find(key);
+            if (it == live.end())
+                continue; //    
+            trace.operations.push_back({ false, it->second.first, it->second.second });
+            live.erase(it);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,252 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include "Workload.h"
+#include "BuddyManager.h"
+#include "BoundaryTagManager.h"
+#include "SortedListManager.h"
+#include "RedBlackManager.h"
+#include "SlabAllocator.h"
+
+//      ,    ( )
+class SystemManager {
+public:
+    SystemManager(size_t size) { (void)size; }
+    void* allocate(size_t size) { return std::malloc(size); }
+    void deallocate(void* address, size_t size) { (void)size; std::free(address); }
+};
+
+//       
+struct Result {
+    double opsPerSecond = 0;
+    double p50 = 0, p99 = 0, p999 = 0; //  ,  (   ~20 )
+    size_t peakLive = 0;               //    
+    size_t peakFootprint = 0;          //         
+    double fragmentation = -1;         //   1 - largest/free    
+    size_t failures = 0;               // ,  nullptr
+};
+
+template <class Manager>
+void releaseAll(Manager& manager, std::vector<std::pair<char*, size_t>>& slots) {
+    for (auto& slot : slots) {
+        if (slot.first)
+            manager.deallocate(slot.first, slot.second);
+        slot = { nullptr, 0 };
+    }
+}
+
+template <class Manager>
+Result replay(const Trace& trace, size_t poolSize) {
+    Result result;
+    const auto& operations = trace.operations;
+    std::vector<std::pair<char*, size_t>> slots(trace.blocks, { nullptr, 0 });
+
+    //  1:       
+    {
+        auto manager = std::make_unique<Manager>(poolSize);
+        auto start = std::chrono::steady_clock::now();
+        for (const Operation& op : operations) {
+            auto& slot = slots[op.id];
+            if (op.allocate) {
+                slot.first = static_cast<char*>(manager->allocate(op.size));
+                slot.second = op.size;
+            }
+            else if (slot.first) {
+                manager->deallocate(slot.first, slot.second);
+                slot.first = nullptr;
+            }
+        }
+        auto finish = std::chrono::steady_clock::now();
+        releaseAll(*manager, slots);
+        result.opsPerSecond = operations.size() / std::chrono::duration<double>(finish - start).count();
+    }
+
+    //  2: ,    
+    auto manager = std::make_unique<Manager>(poolSize);
+    std::vector<uint32_t> latencies;
+    latencies.reserve(operations.size());
+    char* low = nullptr;
+    char* high = nullptr;
+    size_t live = 0;
+    size_t sampledLive = 0;
+
+    for (size_t i = 0; i < operations.size(); ++i) {
+        const Operation& op = operations[i];
+        auto& slot = slots[op.id];
+        auto start = std::chrono::steady_clock::now();
+        if (op.allocate) {
+            slot.first = static_cast<char*>(manager->allocate(op.size));
+            slot.second = op.size;
+        }
+        else if (slot.first) {
+            manager->deallocate(slot.first, slot.second);
+        }
+        auto finish = std::chrono::steady_clock::now();
+        latencies.push_back(static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(finish - start).count()));
+
+        if (op.allocate) {
+            if (!slot.first) {
+                ++result.failures;
+                continue;
+            }
+            live += op.size;
+            if (!low || slot.first < low) low = slot.first;
+            if (slot.first + op.size > high) high = slot.first + op.size;
+            result.peakLive = std::max(result.peakLive, live);
+            result.peakFootprint = std::max(result.peakFootprint, static_cast<size_t>(high - low));
+        }
+        else if (slot.first) {
+            live -= slot.second;
+            slot.first = nullptr;
+        }
+
+        //    -       
+        if constexpr (requires(const Manager& m) { m.freeBytes(); m.largestFreeBlock(); }) {
+            if (i % 1024 == 0 && live >= sampledLive) {
+                size_t freeBytes = manager->freeBytes();
+                sampledLive = live;
+                result.fragmentation = freeBytes ? 1.0 - static_cast<double>(manager->largestFreeBlock()) / freeBytes : 0.0;
+            }
+        }
+    }
+    releaseAll(*manager, slots);
+
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double q) {
+        return latencies.empty() ? 0.0 : static_cast<double>(latencies[static_cast<size_t>(q * (latencies.size() - 1))]);
+    };
+    result.p50 = percentile(0.50);
+    result.p99 = percentile(0.99);
+    result.p999 = percentile(0.999);
+    return result;
+}
+
+void printHeader() {
+    std::cout << std::left << std::setw(18) << "workload" << std::setw(15) << "manager"
+              << std::right << std::setw(12) << "Mops/s" << std::setw(9) << "p50ns" << std::setw(9) << "p99ns"
+              << std::setw(9) << "p999ns" << std::setw(11) << "liveKiB" << std::setw(11) << "spanKiB"
+              << std::setw(8) << "frag" << std::setw(8) << "fails" << std::endl;
+}
+
+template <class Manager>
+void report(const Trace& trace, const char* name, size_t poolSize) {
+    Result r = replay<Manager>(trace, poolSize);
+    std::cout << std::left << std::setw(18) << trace.name << std::setw(15) << name << std::right << std::fixed
+              << std::setprecision(2) << std::setw(12) << r.opsPerSecond / 1e6
+              << std::setprecision(0) << std::setw(9) << r.p50 << std::setw(9) << r.p99 << std::setw(9) << r.p999
+              << std::setw(11) << r.peakLive / 1024 << std::setw(11) << r.peakFootprint / 1024;
+    if (r.fragmentation >= 0) std::cout << std::setprecision(3) << std::setw(8) << r.fragmentation;
+    else std::cout << std::setw(8) << "-";
+    std::cout << std::setw(8) << r.failures << std::endl;
+}
+
+void runAll(const Trace& trace, size_t poolSize) {
+    //     -    
+    report<Buddy::MemoryManager<Buddy::BestFit>>(trace, "buddy/best", poolSize);
+    report<Buddy::MemoryManager<Buddy::WorstFit>>(trace, "buddy/worst", poolSize);
+    report<BoundaryTags::MemoryManager<BoundaryTags::FirstFit>>(trace, "tags/first", poolSize);
+    report<BoundaryTags::MemoryManager<BoundaryTags::NextFit>>(trace, "tags/next", poolSize);
+    report<BoundaryTags::MemoryManager<BoundaryTags::BestFit>>(trace, "tags/best", poolSize);
+    report<BoundaryTags::MemoryManager<BoundaryTags::WorstFit>>(trace, "tags/worst", poolSize);
+    report<SortedList::MemoryManager<SortedList::FirstFit>>(trace, "list/first", poolSize);
+    report<SortedList::MemoryManager<SortedList::NextFit>>(trace, "list/next", poolSize);
+    report<SortedList::MemoryManager<SortedList::BestFit>>(trace, "list/best", poolSize);
+    report<SortedList::MemoryManager<SortedList::WorstFit>>(trace, "list/worst", poolSize);
+    report<SortedList::MemoryManager<SortedList::IndexedBestFit>>(trace, "list/best-idx", poolSize);
+    report<SortedList::MemoryManager<SortedList::IndexedWorstFit>>(trace, "list/worst-idx", poolSize);
+    report<RedBlack::MemoryManager<RedBlack::BestFit>>(trace, "red-black/best", poolSize);
+    report<RedBlack::MemoryManager<RedBlack::WorstFit>>(trace, "red-black/worst", poolSize);
+    report<SlabAllocator<Buddy::MemoryManager<>>>(trace, "slab/buddy", poolSize);
+    report<SlabAllocator<BoundaryTags::MemoryManager<>>>(trace, "slab/tags", poolSize);
+    report<SystemManager>(trace, "malloc", poolSize);
+}
+
+//   : allocateBatch/deallocateBatch      .
+//   ,         ,    .
+template <class Manager>
+void reportBatch(const char* name, size_t poolSize) {
+    const size_t objectSize = 64;
+    const size_t batch = 256;
+    const int rounds = 2000;
+    auto manager = std::make_unique<Manager>(poolSize);
+
+    // : 20000   ,   
+    std::mt19937 rng(5);
+    std::vector<std::pair<void*, size_t>> background;
+    for (int i = 0; i < 20000; ++i) {
+        size_t size = 16 + rng() % 1000;
+        background.push_back({ manager->allocate(size), size });
+    }
+    for (size_t i = 0; i < background.size(); i += 2) {
+        manager->deallocate(background[i].first, background[i].second);
+        background[i].first = nullptr;
+    }
+
+    std::vector<void*> objects(batch);
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; ++round) {
+        for (size_t i = 0; i < batch; ++i)
+            objects[i] = manager->allocate(objectSize);
+        for (size_t i = 0; i < batch; ++i)
+            manager->deallocate(objects[i], objectSize);
+    }
+    auto middle = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; ++round) {
+        size_t count = manager->allocateBatch(objectSize, batch, objects.data());
+        manager->deallocateBatch(objects.data(), count, objectSize);
+    }
+    auto finish = std::chrono::steady_clock::now();
+
+    for (auto& block : background)
+        manager->deallocate(block.first, block.second);
+
+    double total = static_cast<double>(rounds) * batch;
+    double single = std::chrono::duration<double, std::nano>(middle - start).count() / total;
+    double batched = std::chrono::duration<double, std::nano>(finish - middle).count() / total;
+    std::cout << std::left << std::setw(15) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(14) << single << std::setw(14) << batched
+              << std::setprecision(2) << std::setw(10) << single / batched << std::endl;
+}
+
+void runBatch(size_t poolSize) {
+    std::cout << std::left << std::setw(15) << "manager" << std::right << std::setw(14) << "single ns/obj"
+              << std::setw(14) << "batch ns/obj" << std::setw(10) << "speedup" << std::endl;
+    reportBatch<Buddy::MemoryManager<>>("buddy", poolSize);
+    reportBatch<BoundaryTags::MemoryManager<>>("boundary-tags", poolSize);
+    reportBatch<SortedList::MemoryManager<>>("sorted-list", poolSize);
+    reportBatch<RedBlack::MemoryManager<>>("red-black", poolSize);
+}
+
+//    -  ,   -   
+int main(int argc, char** argv) {
+    const size_t poolSize = size_t(256) << 20;
+    printHeader();
+
+    if (argc > 1) {
+        for (int i = 1; i < argc; ++i) {
+            Trace trace;
+            if (!loadTrace(argv[i], trace)) {
+                std::cerr << "cannot read trace " << argv[i] << std::endl;
+                continue;
+            }
+            runAll(trace, poolSize);
+        }
+        return 0;
+    }
+
+    for (SizeDistribution distribution : { SizeDistribution::Uniform, SizeDistribution::PowerLaw }) {
+        for (FreeOrder order : { FreeOrder::Lifo, FreeOrder::Fifo, FreeOrder::Random }) {
+            Trace trace = generateTrace(distribution, order, 10000, 200000);
+            runAll(trace, poolSize);
+        }
+    }
+
+    std::cout << std::endl;
+    runBatch(poolSize);
+    return 0;
+}
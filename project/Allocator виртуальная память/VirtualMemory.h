@@ -0,0 +1,217 @@
+//HugePages :    :  ,  (THP  Linux)   (MAP_HUGETLB / MEM_LARGE_PAGES).
+//PoolOptions :    :  ,  ,     ,  ,  NUMA.
+//Region :    .     ,        -    NUMA,   .
+//Region::commit(size_t size) :      size   .
+//Region::discard(char* from, char* to) :      [from, to) (madvise(MADV_DONTNEED) / MEM_RESET),    .
+//Region::revoke() :      :     -   .
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace VirtualMemory {
+
+enum class HugePages { None, Transparent, Explicit };
+
+static const int kAnyNode = -1; //  NUMA  :    ,   
+
+//  .     ,     1MB   .
+struct PoolOptions {
+    size_t reserve = 0;                     //    ( ); 0 -   
+    size_t arenaSize = 0;                   //   ; 0 -   
+    size_t releaseThreshold = size_t(1) << 20; //        ; 0 - 
+    HugePages hugePages = HugePages::None;  //   
+    int numaNode = kAnyNode;                //  NUMA   
+};
+
+static const size_t kHugePageSize = size_t(2) << 20; //   x86-64
+
+inline size_t systemPageSize() {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwPageSize;
+#else
+    return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+inline size_t roundUp(size_t value, size_t granularity) {
+    return (value + granularity - 1) / granularity * granularity;
+}
+
+//   .     ,   ,  
+//      ,  RSS     .
+class Region {
+public:
+    // numaNode -  NUMA,        ( 
+    //   -  );    NUMA      
+    Region(size_t size, HugePages mode = HugePages::None, int numaNode = kAnyNode)
+        : base(nullptr), reservedSize(0), committedSize(0), page(systemPageSize()), locked(false) {
+        size_t granularity = mode == HugePages::None ? page : kHugePageSize;
+        reservedSize = roundUp(size ? size : 1, granularity);
+#ifdef _WIN32
+        if (mode == HugePages::Explicit) {
+            //   Windows   SeLockMemoryPrivilege   
+            size_t large = GetLargePageMinimum();
+            if (large) {
+                size_t largeSize = roundUp(reservedSize, large);
+                base = static_cast<char*>(reserve(largeSize, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE, numaNode));
+                if (base) {
+                    reservedSize = committedSize = largeSize;
+                    page = large;
+                    locked = true;
+                    return;
+                }
+            }
+        }
+        //     Windows  -  
+        base = static_cast<char*>(reserve(reservedSize, MEM_RESERVE, PAGE_NOACCESS, numaNode));
+#else
+        if (mode == HugePages::Explicit) {
+            //    hugetlbfs  ,     , 
+            //    ;      -    THP
+            void* p = mmap(nullptr, reservedSize, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (p != MAP_FAILED) {
+                base = static_cast<char*>(p);
+                committedSize = reservedSize;
+                page = kHugePageSize;
+                locked = true;
+                bindToNode(numaNode);
+                return;
+            }
+            mode = HugePages::Transparent;
+        }
+        if (mode == HugePages::Transparent) {
+            //     ,       
+            size_t padded = reservedSize + kHugePageSize;
+            void* p = mmap(nullptr, padded, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+            if (p != MAP_FAILED) {
+                char* raw = static_cast<char*>(p);
+                char* aligned = reinterpret_cast<char*>(roundUp(reinterpret_cast<uintptr_t>(raw), kHugePageSize));
+                if (aligned > raw)
+                    munmap(raw, static_cast<size_t>(aligned - raw));
+                size_t tail = static_cast<size_t>(raw + padded - (aligned + reservedSize));
+                if (tail)
+                    munmap(aligned + reservedSize, tail);
+                base = aligned;
+                madvise(base, reservedSize, MADV_HUGEPAGE);
+            }
+        }
+        else {
+            void* p = mmap(nullptr, reservedSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+            base = p != MAP_FAILED ? static_cast<char*>(p) : nullptr;
+        }
+#endif
+        if (!base)
+            throw std::bad_alloc();
+#ifndef _WIN32
+        bindToNode(numaNode);
+#endif
+    }
+
+    ~Region() {
+#ifdef _WIN32
+        VirtualFree(base, 0, MEM_RELEASE);
+#else
+        munmap(base, reservedSize);
+#endif
+    }
+
+    Region(const Region&) = delete;
+    Region& operator=(const Region&) = delete;
+
+    char* begin() const { return base; }
+    size_t reserved() const { return reservedSize; }
+    size_t committed() const { return committedSize; }
+    size_t pageSize() const { return page; }
+
+    //     size  (   ); false -  
+    bool commit(size_t size) {
+        if (size <= committedSize)
+            return true;
+        if (size > reservedSize)
+            return false;
+        size_t target = roundUp(size, page);
+        if (target > reservedSize)
+            target = reservedSize;
+#ifdef _WIN32
+        if (!VirtualAlloc(base + committedSize, target - committedSize, MEM_COMMIT, PAGE_READWRITE))
+            return false;
+#else
+        if (mprotect(base + committedSize, target - committedSize, PROT_READ | PROT_WRITE) != 0)
+            return false;
+#endif
+        committedSize = target;
+        return true;
+    }
+
+    //      [from, to).   ,  
+    // :  Linux     ,  Windows -   .
+    void discard(char* from, char* to) {
+        char* first = reinterpret_cast<char*>(roundUp(reinterpret_cast<uintptr_t>(from), page));
+        char* last = reinterpret_cast<char*>(reinterpret_cast<uintptr_t>(to) / page * page);
+        if (first >= last)
+            return;
+#ifdef _WIN32
+        if (!locked)
+            VirtualAlloc(first, static_cast<size_t>(last - first), MEM_RESET, PAGE_READWRITE);
+#else
+        madvise(first, static_cast<size_t>(last - first), MADV_DONTNEED);
+#endif
+    }
+
+    //     (PROT_NONE / PAGE_NOACCESS),   
+    //      
+    void revoke() {
+        if (!committedSize)
+            return;
+#ifdef _WIN32
+        DWORD previous;
+        VirtualProtect(base, committedSize, PAGE_NOACCESS, &previous);
+#else
+        mprotect(base, committedSize, PROT_NONE);
+#endif
+    }
+
+private:
+#ifdef _WIN32
+    static void* reserve(size_t size, DWORD type, DWORD protection, int numaNode) {
+        if (numaNode == kAnyNode)
+            return VirtualAlloc(nullptr, size, type, protection);
+        return VirtualAllocExNuma(GetCurrentProcess(), nullptr, size, type, protection, static_cast<DWORD>(numaNode));
+    }
+#else
+    //  MPOL_PREFERRED   :   mprotect   
+    //   ,    .  (  NUMA,  )   -
+    //    .
+    void bindToNode(int numaNode) {
+        static const int kPreferred = 1; // MPOL_PREFERRED  <numaif.h>,    libnuma
+        const unsigned long kMaxNodes = sizeof(unsigned long) * 8;
+        if (numaNode < 0 || static_cast<unsigned long>(numaNode) >= kMaxNodes - 1) //   maxnode - 1 
+            return;
+        unsigned long mask = 1UL << numaNode;
+        syscall(SYS_mbind, base, reservedSize, kPreferred, &mask, kMaxNodes, 0);
+    }
+#endif
+
+    char* base;           //  
+    size_t reservedSize;  //  
+    size_t committedSize; //    
+    size_t page;          //     
+    bool locked;          //   Windows      
+};
+
+} // namespace VirtualMemory
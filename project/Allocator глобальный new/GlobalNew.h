@@ -0,0 +1,142 @@
+//GlobalNew.h :   operator new/delete  .          GLOBAL_NEW_MANAGER.
+//GlobalNew::Heap :     .     new   ,       .
+//GlobalNew::allocate(size_t size) :    new_handler,   - std::bad_alloc.
+//GlobalNew::deallocate(void* address) :    -       .
+//GlobalNew::allocateAligned(size_t size, size_t alignment) :     ,      .
+//
+//       (  VirtualMemory::Region:  ,
+// )   ,   __STDCPP_DEFAULT_NEW_ALIGNMENT__.
+//:
+//  #define GLOBAL_NEW_MANAGER Buddy::MemoryManager<>
+//  #include "BuddyManager.h"
+//  #include "GlobalNew.h"
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include "VirtualMemory.h"
+
+#ifndef GLOBAL_NEW_MANAGER
+#error "GLOBAL_NEW_MANAGER must name the memory manager type before GlobalNew.h is included"
+#endif
+
+#ifndef GLOBAL_NEW_POOL_SIZE
+#define GLOBAL_NEW_POOL_SIZE (size_t(64) << 20) //  
+#endif
+
+#ifndef GLOBAL_NEW_RESERVE
+#define GLOBAL_NEW_RESERVE (size_t(64) << 30)   //    (  )
+#endif
+
+namespace GlobalNew {
+
+struct Heap {
+    std::mutex mutex;
+    GLOBAL_NEW_MANAGER manager;
+
+    Heap() : manager(GLOBAL_NEW_POOL_SIZE, options()) {}
+
+    static VirtualMemory::PoolOptions options() {
+        VirtualMemory::PoolOptions result;
+        result.reserve = GLOBAL_NEW_RESERVE;
+        return result;
+    }
+};
+
+//     :     new,     
+inline Heap& heap() {
+    alignas(Heap) static unsigned char storage[sizeof(Heap)];
+    static Heap* instance = ::new (static_cast<void*>(storage)) Heap();
+    return *instance;
+}
+
+inline void* allocate(size_t size) {
+    if (size == 0)
+        size = 1; // new        
+    for (;;) {
+        void* address;
+        {
+            Heap& h = heap();
+            std::lock_guard<std::mutex> lock(h.mutex);
+            address = h.manager.allocate(size);
+        }
+        if (address)
+            return address;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler)
+            throw std::bad_alloc();
+        handler();
+    }
+}
+
+inline void deallocate(void* address) {
+    if (!address)
+        return;
+    Heap& h = heap();
+    std::lock_guard<std::mutex> lock(h.mutex);
+    h.manager.deallocate(address);
+}
+
+//             .
+//   ,    size_t, - ,      .
+inline void* allocateAligned(size_t size, size_t alignment) {
+    if (size > SIZE_MAX - alignment)
+        throw std::bad_alloc();
+    char* raw = static_cast<char*>(allocate(size + alignment));
+    uintptr_t aligned = (reinterpret_cast<uintptr_t>(raw) + sizeof(void*) + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+    reinterpret_cast<void**>(aligned)[-1] = raw;
+    return reinterpret_cast<void*>(aligned);
+}
+
+inline void deallocateAligned(void* address) {
+    if (address)
+        deallocate(static_cast<void**>(address)[-1]);
+}
+
+} // namespace GlobalNew
+
+void* operator new(std::size_t size) { return GlobalNew::allocate(size); }
+void* operator new[](std::size_t size) { return GlobalNew::allocate(size); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try { return GlobalNew::allocate(size); }
+    catch (...) { return nullptr; }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try { return GlobalNew::allocate(size); }
+    catch (...) { return nullptr; }
+}
+
+void operator delete(void* address) noexcept { GlobalNew::deallocate(address); }
+void operator delete[](void* address) noexcept { GlobalNew::deallocate(address); }
+void operator delete(void* address, std::size_t) noexcept { GlobalNew::deallocate(address); }
+void operator delete[](void* address, std::size_t) noexcept { GlobalNew::deallocate(address); }
+void operator delete(void* address, const std::nothrow_t&) noexcept { GlobalNew::deallocate(address); }
+void operator delete[](void* address, const std::nothrow_t&) noexcept { GlobalNew::deallocate(address); }
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return GlobalNew::allocateAligned(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return GlobalNew::allocateAligned(size, static_cast<size_t>(alignment));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try { return GlobalNew::allocateAligned(size, static_cast<size_t>(alignment)); }
+    catch (...) { return nullptr; }
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try { return GlobalNew::allocateAligned(size, static_cast<size_t>(alignment)); }
+    catch (...) { return nullptr; }
+}
+
+void operator delete(void* address, std::align_val_t) noexcept { GlobalNew::deallocateAligned(address); }
+void operator delete[](void* address, std::align_val_t) noexcept { GlobalNew::deallocateAligned(address); }
+void operator delete(void* address, std::size_t, std::align_val_t) noexcept { GlobalNew::deallocateAligned(address); }
+void operator delete[](void* address, std::size_t, std::align_val_t) noexcept { GlobalNew::deallocateAligned(address); }
+void operator delete(void* address, std::align_val_t, const std::nothrow_t&) noexcept { GlobalNew::deallocateAligned(address); }
+void operator delete[](void* address, std::align_val_t, const std::nothrow_t&) noexcept { GlobalNew::deallocateAligned(address); }
@@ -0,0 +1,74 @@
+#define ALLOCATOR_STATS //        
+#define GLOBAL_NEW_MANAGER Buddy::MemoryManager<>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <map>
+#include <memory>
+#include <thread>
+#include <chrono>
+#include <cassert>
+#include <cstdint>
+#include "BuddyManager.h"
+#include "GlobalNew.h"
+
+//        aligned new
+struct alignas(64) CacheLine {
+    char data[64];
+};
+
+//  :  ,      ,
+//          
+int main() {
+    std::vector<std::string> words;
+    for (int i = 0; i < 10000; ++i)
+        words.push_back("word number " + std::to_string(i));
+
+    std::map<int, std::string> index;
+    for (int i = 0; i < 10000; ++i)
+        index[i] = words[i];
+
+    auto line = std::make_unique<CacheLine>();
+    assert(reinterpret_cast<uintptr_t>(line.get()) % alignof(CacheLine) == 0);
+
+    //         size_t - ,    
+    volatile size_t huge = SIZE_MAX - 8;
+    assert(::operator new(huge, std::align_val_t(alignof(CacheLine)), std::nothrow) == nullptr);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([] {
+            for (int i = 0; i < 100000; ++i)
+                delete new int(i);
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    //   new/delete     :
+    //      - new  delete      40 
+    const int objects = 100000;
+    std::vector<std::string*> strings(objects);
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < objects; ++i)
+            strings[i] = new std::string(40, 'x');
+        for (int i = 0; i < objects; ++i)
+            delete strings[i];
+    }
+    auto finish = std::chrono::steady_clock::now();
+    std::cout << "new/delete Mops/s: " << std::fixed << std::setprecision(2)
+              << 4.0 * 10 * objects / std::chrono::duration<double, std::micro>(finish - start).count() << std::endl;
+
+    //     ,      (    )
+    Stats::Snapshot snapshot;
+    {
+        GlobalNew::Heap& heap = GlobalNew::heap();
+        std::lock_guard<std::mutex> lock(heap.mutex);
+        snapshot = Stats::snapshot(heap.manager);
+    }
+    Stats::writeJson(std::cout, snapshot, "global-new");
+    std::cout << std::endl;
+    return 0;
+}
@@ -0,0 +1,644 @@
+//MemoryBlock:       .
+//FreeBlock :      :                 .
+//MemoryManager :         .
+//FirstFit, NextFit, BestFit, WorstFit :   -   MemoryManager,     .
+//allocate(size_t size) :      .  :        (       )  O(1),     .
+//deallocate(void* address) :        .     ,         O(1)  .      .
+//deallocate(void* address, size_t size) :    ,    (  ).
+//allocateBatch(size_t size, size_t count, void** out) :         ,     -.
+//deallocateBatch(void** ptrs, size_t count, size_t size) :  :            .
+//slideDown(void* address) :             ( );          .    .
+//nextAllocated(void* address) :     address      (nullptr  address -   ), nullptr -    .
+//grow(size_t needed) :        ,      .
+//trim() :      .
+//owns(const void* address) :        (   ).
+//forEachFreeBlock(Visit visit) :       Stats::snapshot,      ALLOCATOR_STATS.
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <functional>
+#include <new>
+#include <bit>
+#include "AllocatorStats.h"
+#include "VirtualMemory.h"
+
+namespace BoundaryTags {
+
+//       
+struct MemoryBlock {
+    void* address; //    
+    size_t size;   //   
+
+    MemoryBlock(void* addr, size_t sz) : address(addr), size(sz) {}
+};
+
+//       (   )
+struct FreeBlock {
+    size_t size;     //  :  ,   -  ""
+    FreeBlock* prev; //       
+    FreeBlock* next; //       
+    //  sizeof(size_t)      -   
+};
+
+//  .  -   MemoryManager   : 
+//    ,       
+//   .  forget ,      .
+struct PlacementPolicy {
+    void forget(FreeBlock* block, FreeBlock* replacement) { (void)block; (void)replacement; }
+};
+
+//      ,     (O(1),  TLSF)
+struct FirstFit : PlacementPolicy {
+    template <class Manager>
+    FreeBlock* find(Manager& manager, size_t needed, Stats::Probe& probe) {
+        int fl, sl;
+        Manager::mappingInsert(Manager::roundUpToClass(needed), fl, sl);
+        if (fl >= Manager::kFlCount)
+            return nullptr;
+        probe.step();
+        return manager.findSuitableBlock(fl, sl);
+    }
+};
+
+//   :        
+struct NextFit : PlacementPolicy {
+    FreeBlock* rover = nullptr; // ,     
+
+    template <class Manager>
+    FreeBlock* find(Manager& manager, size_t needed, Stats::Probe& probe) {
+        char* start = rover ? reinterpret_cast<char*>(rover) : manager.poolBegin;
+        if (FreeBlock* block = scan<Manager>(start, manager.poolEnd, needed, probe))
+            return rover = block;
+        if (FreeBlock* block = scan<Manager>(manager.poolBegin, start, needed, probe))
+            return rover = block;
+        return nullptr;
+    }
+
+    void forget(FreeBlock* block, FreeBlock* replacement) {
+        if (rover == block)
+            rover = replacement;
+    }
+
+private:
+    template <class Manager>
+    static FreeBlock* scan(char* from, char* to, size_t needed, Stats::Probe& probe) {
+        for (char* p = from; p < to; p += Manager::sizeOf(reinterpret_cast<FreeBlock*>(p))) {
+            FreeBlock* block = reinterpret_cast<FreeBlock*>(p);
+            probe.step();
+            if (Manager::isFree(block) && Manager::sizeOf(block) >= needed)
+                return block;
+        }
+        return nullptr;
+    }
+};
+
+//   :    ,     
+struct BestFit : PlacementPolicy {
+    template <class Manager>
+    FreeBlock* find(Manager& manager, size_t needed, Stats::Probe& probe) {
+        int fl, sl;
+        Manager::mappingInsert(needed, fl, sl);
+        if (fl >= Manager::kFlCount)
+            return nullptr;
+        if (FreeBlock* block = smallest<Manager>(manager.freeBlocks[fl][sl], needed, probe))
+            return block;
+        ++sl; //     ,  -   
+        return smallest<Manager>(manager.findSuitableBlock(fl, sl), needed, probe);
+    }
+
+private:
+    template <class Manager>
+    static FreeBlock* smallest(FreeBlock* list, size_t needed, Stats::Probe& probe) {
+        FreeBlock* best = nullptr;
+        for (FreeBlock* block = list; block; block = block->next) {
+            probe.step();
+            size_t size = Manager::sizeOf(block);
+            if (size >= needed && (!best || size < Manager::sizeOf(best))) {
+                best = block;
+                if (size == needed)
+                    break;
+            }
+        }
+        return best;
+    }
+};
+
+//   :      
+struct WorstFit : PlacementPolicy {
+    template <class Manager>
+    FreeBlock* find(Manager& manager, size_t needed, Stats::Probe& probe) {
+        FreeBlock* block = manager.largestFree(probe);
+        return block && Manager::sizeOf(block) >= needed ? block : nullptr;
+    }
+};
+
+//         
+template <class Policy = FirstFit>
+class MemoryManager {
+public:
+    static const size_t kAlignment = 16;            //       
+
+private:
+    friend Policy;
+
+    static const size_t kTagSize = sizeof(size_t);  //   
+    static const size_t kFreeFlag = 1;              //     
+    static const size_t kMinBlockSize = (sizeof(FreeBlock) + kTagSize + kAlignment - 1) & ~(kAlignment - 1);
+
+    //   
+    static const int kSlLog2 = 4;                             // log2    
+    static const int kSlCount = 1 << kSlLog2;                 //    
+    static const int kFlShift = kSlLog2 + 4;                  //     (4 = log2(kAlignment))
+    static const size_t kSmallBlock = size_t(1) << kFlShift;  //        0
+    static const int kFlMax = 64;                             //    2^kFlMax -    size_t
+    static const int kFlCount = kFlMax - kFlShift + 1;        //     (  64  flBitmap)
+
+    size_t memorySize;    //   
+    size_t arenaSize;     //    
+    size_t releaseThreshold;     //        
+    size_t pendingRelease;       //      
+    VirtualMemory::Region pool;  //   
+    char* poolBegin;      //   : kTagSize    
+    char* poolEnd;        //    
+    uint64_t flBitmap;                          //    
+    uint32_t slBitmap[kFlCount];                //    
+    FreeBlock* freeBlocks[kFlCount][kSlCount];  //     
+    size_t freeCount;                           //   
+    size_t freeTotal;                           //    
+    Policy policy;                              //  
+    ALLOCATOR_STAT(Stats::Counters stats;)      //  
+
+public:
+    MemoryManager(size_t size, const VirtualMemory::PoolOptions& options = VirtualMemory::PoolOptions())
+        : memorySize(std::max(size, options.reserve)), arenaSize(options.arenaSize ? options.arenaSize : size),
+          releaseThreshold(options.releaseThreshold), pendingRelease(0), pool(memorySize, options.hugePages, options.numaNode),
+          flBitmap(0), freeCount(0), freeTotal(0) {
+        //     ,   .  
+        //     ,      .
+        //    kTagSize   kAlignment:      
+        //   kAlignment,   malloc,      kAlignment
+        poolBegin = pool.begin() + kTagSize;
+        poolEnd = poolBegin + ((size > kTagSize ? size - kTagSize : 0) & ~(kAlignment - 1));
+        if (!pool.commit(size))
+            throw std::bad_alloc();
+
+        for (int fl = 0; fl < kFlCount; ++fl) {
+            slBitmap[fl] = 0;
+            for (int sl = 0; sl < kSlCount; ++sl)
+                freeBlocks[fl][sl] = nullptr;
+        }
+
+        //       
+        size_t poolSize = static_cast<size_t>(poolEnd - poolBegin);
+        if (poolSize >= kMinBlockSize) {
+            FreeBlock* initialBlock = reinterpret_cast<FreeBlock*>(poolBegin);
+            setTags(initialBlock, poolSize, true);
+            insertFreeBlock(initialBlock);
+        }
+    }
+
+    ~MemoryManager() {
+        //     Region
+    }
+
+    MemoryManager(const MemoryManager&) = delete;
+    MemoryManager& operator=(const MemoryManager&) = delete;
+
+    //       (   )
+    void* allocate(size_t size) {
+        if (size == 0 || size > memorySize)
+            return nullptr;
+        size_t needed = blockSizeFor(size);
+
+        Stats::Probe probe;
+        FreeBlock* block = policy.find(*this, needed, probe);
+        while (!block && grow(needed))
+            block = policy.find(*this, needed, probe);
+        if (!block) {
+            //     ,  nullptr
+            ALLOCATOR_STAT(stats.onAllocate(size, 0, probe));
+            return nullptr;
+        }
+        removeFreeBlock(block);
+
+        //  ,       
+        size_t blockSize = sizeOf(block);
+        if (blockSize - needed >= kMinBlockSize) {
+            FreeBlock* rest = reinterpret_cast<FreeBlock*>(reinterpret_cast<char*>(block) + needed);
+            setTags(rest, blockSize - needed, true);
+            insertFreeBlock(rest);
+            blockSize = needed;
+            ALLOCATOR_STAT(stats.onSplit());
+        }
+
+        //           
+        setTags(block, blockSize, false);
+        ALLOCATOR_STAT(stats.onAllocate(size, blockSize, probe));
+        return reinterpret_cast<char*>(block) + kTagSize;
+    }
+
+    //         (     )
+    void deallocate(void* address) {
+        if (!address)
+            return;
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(reinterpret_cast<char*>(address) - kTagSize);
+        ALLOCATOR_STAT(stats.onDeallocate(sizeOf(block)));
+        freeRange(block, sizeOf(block));
+    }
+
+    void deallocate(void* address, size_t size) {
+        (void)size;
+        deallocate(address);
+    }
+
+    //  count   size  out.       
+    //  ( -   ),       ,  ;
+    //      .    .
+    size_t allocateBatch(size_t size, size_t count, void** out) {
+        if (size == 0 || size > memorySize)
+            return 0;
+        size_t needed = blockSizeFor(size);
+
+        size_t done = 0;
+        while (done < count) {
+            size_t want = needed * std::min(count - done, memorySize / needed);
+            Stats::Probe probe;
+            FreeBlock* block = policy.find(*this, want, probe);
+            if (!block)
+                block = policy.find(*this, needed, probe);
+            while (!block && grow(want))
+                block = policy.find(*this, needed, probe);
+            if (!block) {
+                ALLOCATOR_STAT(stats.onAllocate(size, 0, probe));
+                break;
+            }
+            removeFreeBlock(block);
+
+            //       
+            size_t blockSize = sizeOf(block);
+            size_t take = std::min(count - done, blockSize / needed);
+            size_t rest = blockSize - take * needed;
+            char* chunk = reinterpret_cast<char*>(block);
+            for (size_t i = 0; i < take; ++i) {
+                size_t chunkSize = i + 1 == take && rest < kMinBlockSize ? needed + rest : needed;
+                setTags(reinterpret_cast<FreeBlock*>(chunk), chunkSize, false);
+                out[done++] = chunk + kTagSize;
+                chunk += chunkSize;
+                ALLOCATOR_STAT(stats.onAllocate(size, chunkSize, i == 0 ? probe : Stats::Probe()));
+            }
+            if (rest >= kMinBlockSize) {
+                setTags(reinterpret_cast<FreeBlock*>(chunk), rest, true);
+                insertFreeBlock(reinterpret_cast<FreeBlock*>(chunk));
+                ALLOCATOR_STAT(stats.onSplit());
+            }
+        }
+        return done;
+    }
+
+    //  count   size.     ( ptrs
+    // ),        ,  
+    //          .
+    void deallocateBatch(void** ptrs, size_t count, size_t size) {
+        (void)size;
+        std::sort(ptrs, ptrs + count, [](void* a, void* b) { return std::less<void*>()(a, b); });
+        for (size_t i = 0; i < count; ) {
+            if (!ptrs[i]) {
+                ++i;
+                continue;
+            }
+            FreeBlock* block = reinterpret_cast<FreeBlock*>(reinterpret_cast<char*>(ptrs[i++]) - kTagSize);
+            size_t blockSize = sizeOf(block);
+            ALLOCATOR_STAT(stats.onDeallocate(blockSize));
+            while (i < count && reinterpret_cast<char*>(ptrs[i]) - kTagSize == reinterpret_cast<char*>(block) + blockSize) {
+                FreeBlock* next = reinterpret_cast<FreeBlock*>(reinterpret_cast<char*>(ptrs[i++]) - kTagSize);
+                policy.forget(next, block);
+                blockSize += sizeOf(next);
+                ALLOCATOR_STAT(stats.onDeallocate(sizeOf(next)); stats.onMerge());
+            }
+            freeRange(block, blockSize);
+        }
+    }
+
+    //         :    
+    //  memmove,          .
+    //      O(1).    ,   .
+    void* slideDown(void* address) {
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(reinterpret_cast<char*>(address) - kTagSize);
+        if (reinterpret_cast<char*>(block) <= poolBegin)
+            return address;
+        size_t prevTag = *reinterpret_cast<size_t*>(reinterpret_cast<char*>(block) - kTagSize);
+        if (!(prevTag & kFreeFlag))
+            return address;
+
+        FreeBlock* prev = reinterpret_cast<FreeBlock*>(reinterpret_cast<char*>(block) - (prevTag & ~kFreeFlag));
+        size_t freeSize = sizeOf(prev);
+        size_t blockSize = sizeOf(block);
+        removeFreeBlock(prev);
+        std::memmove(prev, block, blockSize);
+
+        //     ,        -      
+        FreeBlock* hole = reinterpret_cast<FreeBlock*>(reinterpret_cast<char*>(prev) + blockSize);
+        policy.forget(prev, hole);
+        policy.forget(block, hole);
+        char* nextAddress = reinterpret_cast<char*>(hole) + freeSize;
+        if (nextAddress < poolEnd) {
+            FreeBlock* next = reinterpret_cast<FreeBlock*>(nextAddress);
+            if (isFree(next)) {
+                removeFreeBlock(next);
+                policy.forget(next, hole);
+                freeSize += sizeOf(next);
+                ALLOCATOR_STAT(stats.onMerge());
+            }
+        }
+        setTags(hole, freeSize, true);
+        insertFreeBlock(hole);
+        return reinterpret_cast<char*>(prev) + kTagSize;
+    }
+
+    //     :   ,    
+    //      
+    void* nextAllocated(void* address) const {
+        const char* p = address ? reinterpret_cast<const char*>(address) - kTagSize : poolBegin;
+        if (address)
+            p += sizeOf(reinterpret_cast<const FreeBlock*>(p));
+        if (p < poolEnd && isFree(reinterpret_cast<const FreeBlock*>(p)))
+            p += sizeOf(reinterpret_cast<const FreeBlock*>(p));
+        return p < poolEnd ? const_cast<char*>(p) + kTagSize : nullptr;
+    }
+
+    //       arenaSize   .   
+    //       ,   .
+    bool grow(size_t needed) {
+        char* limit = poolBegin + ((pool.reserved() - kTagSize) & ~(kAlignment - 1));
+        size_t step = (std::max(arenaSize, roundUpToClass(needed)) + kAlignment - 1) & ~(kAlignment - 1);
+        char* newEnd = static_cast<size_t>(limit - poolEnd) > step ? poolEnd + step : limit;
+        if (static_cast<size_t>(newEnd - poolEnd) < kMinBlockSize || !pool.commit(static_cast<size_t>(newEnd - pool.begin())))
+            return false;
+
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(poolEnd);
+        size_t blockSize = static_cast<size_t>(newEnd - poolEnd);
+        if (poolEnd > poolBegin) {
+            size_t lastTag = *reinterpret_cast<size_t*>(poolEnd - kTagSize);
+            if (lastTag & kFreeFlag) {
+                FreeBlock* last = reinterpret_cast<FreeBlock*>(poolEnd - (lastTag & ~kFreeFlag));
+                removeFreeBlock(last);
+                policy.forget(block, last);
+                blockSize += sizeOf(last);
+                block = last;
+            }
+        }
+        poolEnd = newEnd;
+        setTags(block, blockSize, true);
+        insertFreeBlock(block);
+        return true;
+    }
+
+    //      
+    void trim() {
+        releaseFree(0);
+    }
+
+    //    
+    size_t poolSize() const { return static_cast<size_t>(poolEnd - poolBegin); }
+
+    //      (   ) -     
+    bool owns(const void* address) const {
+        const char* p = static_cast<const char*>(address);
+        return p >= pool.begin() && p < pool.begin() + pool.reserved();
+    }
+
+    //   
+    size_t freeBlockCount() const { return freeCount; }
+
+    //     (  )
+    size_t freeBytes() const { return freeTotal; }
+
+    //    
+    size_t largestFreeBlock() const {
+        Stats::Probe probe;
+        const FreeBlock* block = largestFree(probe);
+        return block ? sizeOf(block) : 0;
+    }
+
+    //      , visit(size)  
+    template <class Visit>
+    void forEachFreeBlock(Visit visit) const {
+        for (int fl = 0; fl < kFlCount; ++fl) {
+            for (int sl = 0; sl < kSlCount; ++sl) {
+                for (const FreeBlock* block = freeBlocks[fl][sl]; block; block = block->next)
+                    visit(sizeOf(block));
+            }
+        }
+    }
+
+#ifdef ALLOCATOR_STATS
+    const Stats::Counters& counters() const { return stats; }
+#endif
+
+    //   :         
+    bool isConsistent() const {
+        size_t freeBlocksInPool = 0;
+        bool prevFree = false;
+        for (const char* p = poolBegin; p < poolEnd; ) {
+            const FreeBlock* block = reinterpret_cast<const FreeBlock*>(p);
+            size_t blockSize = sizeOf(block);
+            if (blockSize < kMinBlockSize || blockSize % kAlignment != 0 || p + blockSize > poolEnd)
+                return false;
+            if (*reinterpret_cast<const size_t*>(p + blockSize - kTagSize) != block->size)
+                return false; //     
+            if (isFree(block)) {
+                if (prevFree)
+                    return false; //      
+                ++freeBlocksInPool;
+            }
+            prevFree = isFree(block);
+            p += blockSize;
+        }
+
+        size_t freeBlocksInLists = 0;
+        for (int fl = 0; fl < kFlCount; ++fl) {
+            for (int sl = 0; sl < kSlCount; ++sl) {
+                bool listEmpty = freeBlocks[fl][sl] == nullptr;
+                if (listEmpty == ((slBitmap[fl] >> sl) & 1u))
+                    return false; //      
+                for (const FreeBlock* block = freeBlocks[fl][sl]; block; block = block->next) {
+                    int blockFl, blockSl;
+                    mappingInsert(sizeOf(block), blockFl, blockSl);
+                    if (!isFree(block) || blockFl != fl || blockSl != sl)
+                        return false;
+                    ++freeBlocksInLists;
+                }
+            }
+            if ((slBitmap[fl] != 0) != ((flBitmap >> fl) & 1u))
+                return false;
+        }
+        return freeBlocksInPool == freeCount && freeBlocksInLists == freeCount;
+    }
+
+private:
+    //   [block, block + blockSize)   :   
+    //   ,      
+    void freeRange(FreeBlock* block, size_t blockSize) {
+        size_t freed = blockSize;
+
+        //        
+        char* nextAddress = reinterpret_cast<char*>(block) + blockSize;
+        if (nextAddress < poolEnd) {
+            FreeBlock* next = reinterpret_cast<FreeBlock*>(nextAddress);
+            if (isFree(next)) {
+                removeFreeBlock(next);
+                policy.forget(next, block);
+                blockSize += sizeOf(next);
+                ALLOCATOR_STAT(stats.onMerge());
+            }
+        }
+
+        //        
+        if (reinterpret_cast<char*>(block) > poolBegin) {
+            size_t prevTag = *reinterpret_cast<size_t*>(reinterpret_cast<char*>(block) - kTagSize);
+            if (prevTag & kFreeFlag) {
+                FreeBlock* prev = reinterpret_cast<FreeBlock*>(reinterpret_cast<char*>(block) - (prevTag & ~kFreeFlag));
+                removeFreeBlock(prev);
+                policy.forget(block, prev);
+                blockSize += sizeOf(prev);
+                ALLOCATOR_STAT(stats.onMerge());
+                block = prev;
+            }
+        }
+
+        setTags(block, blockSize, true);
+        insertFreeBlock(block);
+
+        //       ,    releaseThreshold
+        //  :      ,    
+        // ,            page fault
+        pendingRelease += freed;
+        if (releaseThreshold && pendingRelease >= releaseThreshold)
+            releaseFree(releaseThreshold);
+    }
+
+    //        minSize,       .
+    //       minSize   .
+    void releaseFree(size_t minSize) {
+        pendingRelease = 0;
+        int fl, sl;
+        mappingInsert(minSize, fl, sl);
+        for (uint64_t flMap = fl < kFlCount ? flBitmap & (~uint64_t(0) << fl) : 0; flMap; flMap &= flMap - 1) {
+            int f = std::countr_zero(flMap);
+            for (uint32_t slMap = slBitmap[f]; slMap; slMap &= slMap - 1) {
+                for (FreeBlock* block = freeBlocks[f][std::countr_zero(slMap)]; block; block = block->next) {
+                    if (sizeOf(block) < minSize)
+                        continue;
+                    char* begin = reinterpret_cast<char*>(block);
+                    pool.discard(begin + sizeof(FreeBlock), begin + sizeOf(block) - kTagSize);
+                }
+            }
+        }
+    }
+
+    //     :    ,  
+    static size_t blockSizeFor(size_t size) {
+        size_t total = (size + 2 * kTagSize + kAlignment - 1) & ~(kAlignment - 1);
+        return total < kMinBlockSize ? kMinBlockSize : total;
+    }
+
+    static size_t sizeOf(const FreeBlock* block) { return block->size & ~kFreeFlag; }
+    static bool isFree(const FreeBlock* block) { return (block->size & kFreeFlag) != 0; }
+
+    //      
+    static void setTags(FreeBlock* block, size_t size, bool free) {
+        size_t tag = size | (free ? kFreeFlag : 0);
+        block->size = tag;
+        *reinterpret_cast<size_t*>(reinterpret_cast<char*>(block) + size - kTagSize) = tag;
+    }
+
+    //  (fl, sl),      
+    static void mappingInsert(size_t size, int& fl, int& sl) {
+        if (size < kSmallBlock) {
+            fl = 0;
+            sl = static_cast<int>(size / (kSmallBlock / kSlCount));
+        }
+        else {
+            int top = static_cast<int>(std::bit_width(size)) - 1;
+            sl = static_cast<int>(size >> (top - kSlLog2)) ^ kSlCount;
+            fl = top - kFlShift + 1;
+        }
+    }
+
+    //      ,      
+    static size_t roundUpToClass(size_t size) {
+        if (size >= kSmallBlock)
+            size += (size_t(1) << (std::bit_width(size) - 1 - kSlLog2)) - 1;
+        return size;
+    }
+
+    //   :      
+    FreeBlock* largestFree(Stats::Probe& probe) const {
+        if (!flBitmap)
+            return nullptr;
+        int fl = static_cast<int>(std::bit_width(flBitmap)) - 1;
+        int sl = static_cast<int>(std::bit_width(slBitmap[fl])) - 1;
+        FreeBlock* largest = freeBlocks[fl][sl];
+        probe.step();
+        for (FreeBlock* block = largest->next; block; block = block->next) {
+            probe.step();
+            if (sizeOf(block) > sizeOf(largest))
+                largest = block;
+        }
+        return largest;
+    }
+
+    //      (fl, sl)   
+    FreeBlock* findSuitableBlock(int& fl, int& sl) {
+        uint32_t slMap = slBitmap[fl] & (~0u << sl);
+        if (!slMap) {
+            uint64_t flMap = fl + 1 < 64 ? flBitmap & (~uint64_t(0) << (fl + 1)) : 0;
+            if (!flMap)
+                return nullptr;
+            fl = std::countr_zero(flMap);
+            slMap = slBitmap[fl];
+        }
+        sl = std::countr_zero(slMap);
+        return freeBlocks[fl][sl];
+    }
+
+    //       
+    void insertFreeBlock(FreeBlock* block) {
+        int fl, sl;
+        mappingInsert(sizeOf(block), fl, sl);
+        FreeBlock* head = freeBlocks[fl][sl];
+        block->prev = nullptr;
+        block->next = head;
+        if (head) head->prev = block;
+        freeBlocks[fl][sl] = block;
+        ++freeCount;
+        freeTotal += sizeOf(block);
+        flBitmap |= uint64_t(1) << fl;
+        slBitmap[fl] |= 1u << sl;
+    }
+
+    void removeFreeBlock(FreeBlock* block) {
+        int fl, sl;
+        mappingInsert(sizeOf(block), fl, sl);
+        removeFreeBlock(block, fl, sl);
+    }
+
+    //        O(1)
+    void removeFreeBlock(FreeBlock* block, int fl, int sl) {
+        if (block->prev) block->prev->next = block->next;
+        else freeBlocks[fl][sl] = block->next;
+        if (block->next) block->next->prev = block->prev;
+        --freeCount;
+        freeTotal -= sizeOf(block);
+
+        if (!freeBlocks[fl][sl]) {
+            slBitmap[fl] &= ~(1u << sl);
+            if (!slBitmap[fl])
+                flBitmap &= ~(uint64_t(1) << fl);
+        }
+    }
+};
+
+} // namespace BoundaryTags
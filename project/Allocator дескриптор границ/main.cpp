@@ -1,203 +1,60 @@
-//MemoryBlock:       .
-//FreeBlock :          .
-//MemoryManager :         .
-//allocate(size_t size) :           .      ,      .
-//deallocate(void* address, size_t size) :          .        ,         .
 #include <iostream>
 #include <vector>
-
-//       
-struct MemoryBlock {
-    void* address; //    
-    size_t size;   //   
-
-    MemoryBlock(void* addr, size_t sz) : address(addr), size(sz) {}
-};
-
-//          
-struct FreeBlock {
-    size_t size;   //   
-    bool free;     // , ,   
-    FreeBlock* next; //   
-
-    FreeBlock(size_t sz, bool fr) : size(sz), free(fr), next(nullptr) {}
-};
-
-//         
-class MemoryManager {
-private:
-    void* memoryPool;     //     
-    size_t memorySize;    //   
-    std::vector<FreeBlock*> freeBlocks; //   
-
-public:
-    MemoryManager(size_t size) : memorySize(size) {
-        //    
-        memoryPool = new char[size];
-
-        //       
-        FreeBlock* initialBlock = new FreeBlock(size, true);
-        freeBlocks.push_back(initialBlock);
-    }
-
-    ~MemoryManager() {
-        //     
-        delete[] reinterpret_cast<char*>(memoryPool);
-        for (auto block : freeBlocks) {
-            delete block;
-        }
-    }
-
-    //       (  )
-    void* allocate(size_t size) {
-        FreeBlock* bestFitBlock = nullptr;
-        size_t bestFitSize = memorySize + 1; //     
-
-        //     
-        for (auto block : freeBlocks) {
-            if (block->free && block->size >= size && block->size < bestFitSize) {
-                bestFitBlock = block;
-                bestFitSize = block->size;
-            }
-        }
-
-        if (bestFitBlock) {
-            //   
-            bestFitBlock->free = false; //    
-
-            //      
-            size_t* boundaryTag = reinterpret_cast<size_t*>(bestFitBlock);
-            *boundaryTag = bestFitBlock->size;
-
-            //       
-            void* allocatedAddress = reinterpret_cast<void*>(reinterpret_cast<char*>(bestFitBlock) + sizeof(size_t));
-
-            //    
-            updateFreeBlocks();
-
-            return allocatedAddress;
-        }
-
-        //     ,  nullptr
-        return nullptr;
-    }
-
-    //       (  )
-    void* allocate(size_t size) {
-        for (auto block : freeBlocks) {
-            if (block->free && block->size >= size) {
-                //   
-                block->free = false; //    
-
-                //      
-                size_t* boundaryTag = reinterpret_cast<size_t*>(block);
-                *boundaryTag = block->size;
-
-                //       
-                void* allocatedAddress = reinterpret_cast<void*>(reinterpret_cast<char*>(block) + sizeof(size_t));
-
-                //    
-                updateFreeBlocks();
-
-                return allocatedAddress;
-            }
-        }
-
-        //     ,  nullptr
-        return nullptr;
-    }
-
-
-
-    //          
-    void deallocate(void* address, size_t size) {
-        //     
-        size_t* boundaryTag = reinterpret_cast<size_t*>(reinterpret_cast<char*>(address) - sizeof(size_t));
-
-        //       
-        size_t blockSize = *boundaryTag;
-
-        //       
-        FreeBlock* newFreeBlock = reinterpret_cast<FreeBlock*>(reinterpret_cast<char*>(address) - sizeof(size_t));
-
-        //    
-        newFreeBlock->size = blockSize;
-        newFreeBlock->free = true;
-
-        //      
-        freeBlocks.push_back(newFreeBlock);
-
-        //    
-        updateFreeBlocks();
-    }
-
-    //       (  )
-    void* allocate(size_t size) {
-        FreeBlock* worstFitBlock = nullptr;
-        size_t worstFitSize = 0; //      
-
-        //     
-        for (auto block : freeBlocks) {
-            if (block->free && block->size >= size && block->size > worstFitSize) {
-                worstFitBlock = block;
-                worstFitSize = block->size;
-            }
+#include <random>
+#include <chrono>
+#include <cassert>
+#include "BoundaryTagManager.h"
+
+using namespace BoundaryTags;
+
+//   "churn":  N        .
+//        N -      O(1),
+//     N       .
+void runChurnBenchmark(size_t liveBlocks) {
+    MemoryManager<> manager(liveBlocks * 1024 + 1024 * 1024);
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<size_t> sizeDist(16, 512);
+
+    std::vector<void*> live(liveBlocks);
+    for (auto& ptr : live)
+        ptr = manager.allocate(sizeDist(rng));
+
+    const size_t batch = 1000;
+    const int rounds = 200;
+    std::vector<size_t> victims(batch);
+    double freeNs = 0, allocNs = 0;
+    for (int round = 0; round < rounds; ++round) {
+        for (auto& index : victims)
+            index = rng() % liveBlocks;
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t index : victims) {
+            manager.deallocate(live[index], 0);
+            live[index] = nullptr;
         }
-
-        if (worstFitBlock) {
-            //   
-            worstFitBlock->free = false; //    
-
-            //      
-            size_t* boundaryTag = reinterpret_cast<size_t*>(worstFitBlock);
-            *boundaryTag = worstFitBlock->size;
-
-            //       
-            void* allocatedAddress = reinterpret_cast<void*>(reinterpret_cast<char*>(worstFitBlock) + sizeof(size_t));
-
-            //    
-            updateFreeBlocks();
-
-            return allocatedAddress;
+        auto middle = std::chrono::steady_clock::now();
+        for (size_t index : victims) {
+            if (!live[index])
+                live[index] = manager.allocate(sizeDist(rng));
         }
+        auto finish = std::chrono::steady_clock::now();
 
-        //     ,  nullptr
-        return nullptr;
+        freeNs += std::chrono::duration<double, std::nano>(middle - start).count();
+        allocNs += std::chrono::duration<double, std::nano>(finish - middle).count();
     }
+    assert(manager.isConsistent());
 
-
-
-private:
-    //       
-    void updateFreeBlocks() {
-        //      
-        std::sort(freeBlocks.begin(), freeBlocks.end(), [](const FreeBlock* a, const FreeBlock* b) {
-            return reinterpret_cast<char*>(a) < reinterpret_cast<char*>(b);
-            });
-
-        //    
-        auto it = freeBlocks.begin();
-        while (it != freeBlocks.end() - 1) {
-            FreeBlock* current = *it;
-            FreeBlock* next = *(it + 1);
-            if (reinterpret_cast<char*>(current) + current->size == reinterpret_cast<char*>(next)) {
-                //  ,   
-                current->size += next->size;
-                //     
-                it = freeBlocks.erase(it + 1);
-                delete next;
-            }
-            else {
-                ++it;
-            }
-        }
-    }
-};
+    double operations = static_cast<double>(batch) * rounds;
+    std::cout << "live=" << liveBlocks
+              << " free_blocks=" << manager.freeBlockCount()
+              << " ns/free=" << freeNs / operations
+              << " ns/alloc=" << allocNs / operations << std::endl;
+}
 
 //  
 int main() {
     //       1MB
-    MemoryManager manager(1024 * 1024);
+    MemoryManager<> manager(1024 * 1024);
 
     //  
     void* ptr1 = manager.allocate(100);
@@ -208,6 +65,20 @@ int main() {
     manager.deallocate(ptr1, 100);
     manager.deallocate(ptr2, 200);
     manager.deallocate(ptr3, 50);
+    assert(manager.isConsistent() && manager.freeBlockCount() == 1);
+
+    //  : 1MB  ,    4MB   1GB
+    VirtualMemory::PoolOptions options;
+    options.reserve = size_t(1) << 30;
+    options.arenaSize = 4 * 1024 * 1024;
+    MemoryManager<> growing(1024 * 1024, options);
+    void* big = growing.allocate(10 * 1024 * 1024);
+    assert(big != nullptr && growing.poolSize() > 10 * 1024 * 1024);
+    growing.deallocate(big, 10 * 1024 * 1024); //    
+    assert(growing.isConsistent() && growing.freeBlockCount() == 1);
+
+    for (size_t liveBlocks : { 1000, 10000, 100000 })
+        runChurnBenchmark(liveBlocks);
 
     return 0;
 }
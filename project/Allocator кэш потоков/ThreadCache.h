@@ -0,0 +1,245 @@
+//CachedAllocator<Manager> :      MemoryManager ( ,  ,  ).       .
+//CachedAllocator::ThreadCache :   :       ()  lock-free  ,   .
+//allocate(size_t size) :    .        O(1),         .
+//deallocate(void* address) :    .    ,  -  MPSC- -,   -    .
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <bit>
+
+template <class Manager>
+class CachedAllocator {
+private:
+    struct Heap;
+
+    //   ,   
+    struct BlockHeader {
+        Heap* owner;  // - (nullptr   ,   )
+        size_t size;  //      
+    };
+
+    //         
+    struct FreeBlock {
+        BlockHeader header;
+        FreeBlock* next;
+    };
+
+    static const size_t kHeaderSize = (sizeof(BlockHeader) + 15) & ~size_t(15);
+    static const int kMinClassLog2 = 4;    //   - 16 
+    static const int kMaxClassLog2 = 10;   //   - 1024 
+    static const int kClassCount = kMaxClassLog2 - kMinClassLog2 + 1;
+    static const size_t kBatch = 32;       //      
+    static const size_t kMaxCached = 2 * kBatch;
+
+    //    
+    struct Magazine {
+        FreeBlock* head = nullptr;
+        size_t count = 0;
+    };
+
+    //   .   ,  CachedAllocator,
+    //             .
+    struct Heap {
+        Magazine magazines[kClassCount];
+        std::atomic<FreeBlock*> remoteFrees{ nullptr }; // MPSC-:  ,   
+        bool attached = false;
+    };
+
+    Manager central;                          //  
+    std::mutex centralMutex;                  //   
+    std::mutex heapsMutex;                    //   
+    std::vector<std::unique_ptr<Heap>> heaps; //  , - 
+
+public:
+    class ThreadCache;
+
+    CachedAllocator(size_t size) : central(size) {}
+
+    ~CachedAllocator() {
+        //   ,       
+        for (auto& heap : heaps) {
+            drainRemoteFrees(*heap);
+            for (int cls = 0; cls < kClassCount; ++cls)
+                flush(*heap, cls, heap->magazines[cls].count);
+        }
+    }
+
+    CachedAllocator(const CachedAllocator&) = delete;
+    CachedAllocator& operator=(const CachedAllocator&) = delete;
+
+    //   .          .
+    class ThreadCache {
+    public:
+        ThreadCache(CachedAllocator& allocator) : allocator(allocator), heap(allocator.attach()) {}
+
+        ~ThreadCache() { allocator.detach(heap); }
+
+        ThreadCache(const ThreadCache&) = delete;
+        ThreadCache& operator=(const ThreadCache&) = delete;
+
+        void* allocate(size_t size) { return allocator.allocateFrom(heap, size); }
+        void deallocate(void* address) { allocator.deallocateFrom(heap, address); }
+
+    private:
+        CachedAllocator& allocator;
+        Heap& heap;
+    };
+
+    //         (      )
+    void* allocateShared(size_t size) {
+        std::lock_guard<std::mutex> lock(centralMutex);
+        return central.allocate(size);
+    }
+
+    void deallocateShared(void* address, size_t size) {
+        std::lock_guard<std::mutex> lock(centralMutex);
+        central.deallocate(address, size);
+    }
+
+private:
+    static int classFor(size_t size) {
+        if (size <= (size_t(1) << kMinClassLog2))
+            return 0;
+        return static_cast<int>(std::bit_width(size - 1)) - kMinClassLog2;
+    }
+
+    static size_t classBlockSize(int cls) {
+        return kHeaderSize + (size_t(1) << (cls + kMinClassLog2));
+    }
+
+    static BlockHeader* headerOf(void* address) {
+        return reinterpret_cast<BlockHeader*>(reinterpret_cast<char*>(address) - kHeaderSize);
+    }
+
+    //      (    )
+    Heap& attach() {
+        std::lock_guard<std::mutex> lock(heapsMutex);
+        for (auto& heap : heaps) {
+            if (!heap->attached) {
+                heap->attached = true;
+                return *heap;
+            }
+        }
+        heaps.push_back(std::make_unique<Heap>());
+        heaps.back()->attached = true;
+        return *heaps.back();
+    }
+
+    //   :      
+    void detach(Heap& heap) {
+        drainRemoteFrees(heap);
+        for (int cls = 0; cls < kClassCount; ++cls)
+            flush(heap, cls, heap.magazines[cls].count);
+        std::lock_guard<std::mutex> lock(heapsMutex);
+        heap.attached = false;
+    }
+
+    void* allocateFrom(Heap& heap, size_t size) {
+        int cls = classFor(size);
+        if (cls >= kClassCount) {
+            //   -    ;       size_t
+            if (size > SIZE_MAX - kHeaderSize)
+                return nullptr;
+            size_t blockSize = kHeaderSize + size;
+            void* raw = allocateShared(blockSize);
+            if (!raw)
+                return nullptr;
+            BlockHeader* header = static_cast<BlockHeader*>(raw);
+            header->owner = nullptr;
+            header->size = blockSize;
+            return reinterpret_cast<char*>(raw) + kHeaderSize;
+        }
+
+        Magazine& magazine = heap.magazines[cls];
+        if (!magazine.head) {
+            drainRemoteFrees(heap);
+            if (!magazine.head)
+                refill(heap, cls);
+            if (!magazine.head)
+                return nullptr;
+        }
+
+        FreeBlock* block = magazine.head;
+        magazine.head = block->next;
+        --magazine.count;
+        return reinterpret_cast<char*>(block) + kHeaderSize;
+    }
+
+    void deallocateFrom(Heap& heap, void* address) {
+        if (!address)
+            return;
+        BlockHeader* header = headerOf(address);
+        Heap* owner = header->owner;
+
+        if (!owner) {
+            deallocateShared(header, header->size);
+            return;
+        }
+
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(header);
+        if (owner != &heap) {
+            //  : lock-free    
+            FreeBlock* head = owner->remoteFrees.load(std::memory_order_relaxed);
+            do {
+                block->next = head;
+            } while (!owner->remoteFrees.compare_exchange_weak(head, block,
+                std::memory_order_release, std::memory_order_relaxed));
+            return;
+        }
+
+        int cls = classFor(header->size - kHeaderSize);
+        pushLocal(heap, cls, block);
+        if (heap.magazines[cls].count > kMaxCached)
+            flush(heap, cls, kBatch);
+    }
+
+    void pushLocal(Heap& heap, int cls, FreeBlock* block) {
+        Magazine& magazine = heap.magazines[cls];
+        block->next = magazine.head;
+        magazine.head = block;
+        ++magazine.count;
+    }
+
+    //        exchange
+    void drainRemoteFrees(Heap& heap) {
+        FreeBlock* block = heap.remoteFrees.exchange(nullptr, std::memory_order_acquire);
+        while (block) {
+            FreeBlock* next = block->next;
+            pushLocal(heap, classFor(block->header.size - kHeaderSize), block);
+            block = next;
+        }
+    }
+
+    //        
+    void refill(Heap& heap, int cls) {
+        size_t blockSize = classBlockSize(cls);
+        std::lock_guard<std::mutex> lock(centralMutex);
+        for (size_t i = 0; i < kBatch; ++i) {
+            void* raw = central.allocate(blockSize);
+            if (!raw)
+                break;
+            FreeBlock* block = static_cast<FreeBlock*>(raw);
+            block->header.owner = &heap;
+            block->header.size = blockSize;
+            pushLocal(heap, cls, block);
+        }
+    }
+
+    //  count         
+    void flush(Heap& heap, int cls, size_t count) {
+        Magazine& magazine = heap.magazines[cls];
+        if (!count)
+            return;
+        std::lock_guard<std::mutex> lock(centralMutex);
+        while (count-- && magazine.head) {
+            FreeBlock* block = magazine.head;
+            magazine.head = block->next;
+            --magazine.count;
+            central.deallocate(block, block->header.size);
+        }
+    }
+};
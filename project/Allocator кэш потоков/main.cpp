@@ -0,0 +1,137 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <memory>
+#include <chrono>
+#include <algorithm>
+#include <cassert>
+#include "ThreadCache.h"
+#include "BuddyManager.h"
+#include "BoundaryTagManager.h"
+#include "SortedListManager.h"
+
+//   :  ,       
+struct Mailbox {
+    std::mutex mutex;
+    std::vector<std::vector<std::pair<void*, size_t>>> batches;
+};
+
+// /:          ,
+//    ,  .   -   .
+// cached = false -         .
+template <class Manager>
+double runProducerConsumer(int threads, bool cached) {
+    typedef CachedAllocator<Manager> Allocator;
+    Allocator allocator(64 * 1024 * 1024);
+    std::vector<Mailbox> mailboxes(threads);
+    const int rounds = 2000;
+    const size_t batch = 64;
+
+    auto worker = [&](int id) {
+        std::unique_ptr<typename Allocator::ThreadCache> cache;
+        if (cached)
+            cache = std::make_unique<typename Allocator::ThreadCache>(allocator);
+
+        auto release = [&](std::vector<std::vector<std::pair<void*, size_t>>>& batches) {
+            for (auto& items : batches) {
+                for (auto& item : items) {
+                    if (cached) cache->deallocate(item.first);
+                    else allocator.deallocateShared(item.first, item.second);
+                }
+            }
+            batches.clear();
+        };
+
+        std::vector<std::vector<std::pair<void*, size_t>>> inbox;
+        for (int round = 0; round < rounds; ++round) {
+            std::vector<std::pair<void*, size_t>> produced(batch);
+            for (size_t i = 0; i < batch; ++i) {
+                size_t size = 16 + (i * 37 + round * 11) % 500;
+                produced[i].first = cached ? cache->allocate(size) : allocator.allocateShared(size);
+                produced[i].second = size;
+            }
+            {
+                Mailbox& next = mailboxes[(id + 1) % threads];
+                std::lock_guard<std::mutex> lock(next.mutex);
+                next.batches.push_back(std::move(produced));
+            }
+            {
+                std::lock_guard<std::mutex> lock(mailboxes[id].mutex);
+                std::swap(inbox, mailboxes[id].batches);
+            }
+            release(inbox);
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (int id = 0; id < threads; ++id)
+        pool.emplace_back(worker, id);
+    for (auto& thread : pool)
+        thread.join();
+    auto finish = std::chrono::steady_clock::now();
+
+    // ,    ,   
+    {
+        std::unique_ptr<typename Allocator::ThreadCache> cache;
+        if (cached)
+            cache = std::make_unique<typename Allocator::ThreadCache>(allocator);
+        for (auto& mailbox : mailboxes) {
+            for (auto& items : mailbox.batches) {
+                for (auto& item : items) {
+                    if (cached) cache->deallocate(item.first);
+                    else allocator.deallocateShared(item.first, item.second);
+                }
+            }
+        }
+    }
+
+    double operations = 2.0 * threads * rounds * batch;
+    return operations / std::chrono::duration<double, std::micro>(finish - start).count();
+}
+
+template <class Manager>
+void runScaling(const char* name, int maxThreads) {
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        double locked = runProducerConsumer<Manager>(threads, false);
+        double cached = runProducerConsumer<Manager>(threads, true);
+        std::cout << name << " threads=" << threads
+                  << " mutex Mops/s=" << locked
+                  << " cached Mops/s=" << cached << std::endl;
+    }
+}
+
+//  
+int main() {
+    //        1MB
+    CachedAllocator<Buddy::MemoryManager<>> allocator(1024 * 1024);
+
+    std::thread other([&] {
+        CachedAllocator<Buddy::MemoryManager<>>::ThreadCache cache(allocator);
+        void* ptr1 = cache.allocate(100);
+        void* ptr2 = cache.allocate(5000); //     
+        cache.deallocate(ptr2);
+        assert(cache.allocate(SIZE_MAX - 8) == nullptr); //       size_t
+
+        // ,  ,   
+        std::thread consumer([&] {
+            CachedAllocator<Buddy::MemoryManager<>>::ThreadCache consumerCache(allocator);
+            consumerCache.deallocate(ptr1);
+        });
+        consumer.join();
+
+        //         
+        void* ptr3 = cache.allocate(100);
+        assert(ptr3 != nullptr);
+        cache.deallocate(ptr3);
+    });
+    other.join();
+
+    int maxThreads = static_cast<int>(std::max(4u, std::thread::hardware_concurrency()));
+    runScaling<Buddy::MemoryManager<>>("buddy", maxThreads);
+    runScaling<BoundaryTags::MemoryManager<>>("boundary-tags", maxThreads);
+    runScaling<SortedList::MemoryManager<>>("sorted-list", maxThreads);
+
+    return 0;
+}
@@ -0,0 +1,916 @@
+//SharedMapping :     (shm_open / CreateFileMapping)      .        .
+//SharedBuddy::MemoryManager :  ,          :  ,          ,   ,          .
+//MemoryManager(name, size, backing) / MemoryManager(name, backing) :   (     )    .  ,    .
+//allocate(size_t size) / deallocate(void* address) :        ( pthread  PTHREAD_PROCESS_SHARED    /   Windows).
+//offsetOf(const void* address) / addressOf(uint64_t offset) :        .    ,   .
+//setRoot(uint64_t offset) / root() :     ,       (,     ).
+//remove(name, backing) :      ;        .
+//MemoryManager(name, size, backing, Open::Restore) :      ( ,   ).       ,       ; startup() ,  . ,     (     ),   -    .
+//checkpoint() : :      ,    .       .
+//check() / recover() :   ,     ;        .
+//abandonedLocks() / rebuilds() :        ,   ,       .
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <bit>
+#include <cstring>
+#include <utility>
+#include <vector>
+#include "AllocatorStats.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+//   (EOWNERDEAD)   glibc, musl  FreeBSD,    macOS. PTHREAD_MUTEX_ROBUST
+//  glibc -  ,   ,   #ifdef .
+#ifndef __APPLE__
+#define SHARED_BUDDY_ROBUST_MUTEX
+#endif
+#endif
+
+namespace SharedBuddy {
+
+//   :     (  "/name")   ()
+enum class Backing { SharedMemory, File };
+
+//          :      
+enum class Open { Replace, Restore };
+
+//      
+enum class Startup {
+    Created,   //  
+    Resumed,   //     ,    
+    Checked,   //    ,    -   
+    Recovered  //   ,  
+};
+
+//   
+struct CheckReport {
+    bool consistent = true;       //  
+    const char* problem = nullptr; //   
+    size_t freeBlocks = 0;        //     
+    size_t freeBytes = 0;
+    size_t allocatedBlocks = 0;   //     
+    size_t allocatedBytes = 0;
+    size_t lostBytes = 0;         // ,     ,    
+};
+
+class SharedMapping {
+public:
+    //    size.       ,   replace == false
+    //       (created() == false)
+    SharedMapping(const std::string& name, Backing backing, size_t size, bool replace = true) : base(nullptr), length(size), fresh(true) {
+#ifdef _WIN32
+        file = INVALID_HANDLE_VALUE;
+        uint64_t size64 = size;
+        if (backing == Backing::File) {
+            file = CreateFileA(name.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                               replace ? CREATE_ALWAYS : OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+                throw std::runtime_error("cannot create " + name);
+            LARGE_INTEGER existing;
+            if (!replace && GetFileSizeEx(file, &existing) && existing.QuadPart > 0) {
+                size64 = 0; //    
+                length = static_cast<size_t>(existing.QuadPart);
+                fresh = false;
+            }
+        }
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, static_cast<DWORD>(size64 >> 32), static_cast<DWORD>(size64),
+                                     backing == Backing::SharedMemory ? name.c_str() : nullptr);
+        if (backing == Backing::SharedMemory && !replace && GetLastError() == ERROR_ALREADY_EXISTS)
+            fresh = false;
+        map(name);
+        if (!fresh && backing == Backing::SharedMemory) {
+            MEMORY_BASIC_INFORMATION info;
+            VirtualQuery(base, &info, sizeof(info));
+            length = info.RegionSize;
+        }
+#else
+        int flags = O_RDWR | O_CREAT | (replace ? O_TRUNC : 0);
+        fd = backing == Backing::SharedMemory ? shm_open(name.c_str(), flags, 0600) : open(name.c_str(), flags, 0600);
+        if (fd < 0)
+            throw std::runtime_error("cannot create " + name);
+        struct stat info;
+        if (!replace && fstat(fd, &info) == 0 && info.st_size > 0) {
+            length = static_cast<size_t>(info.st_size);
+            fresh = false;
+        }
+        else if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            close(fd);
+            throw std::runtime_error("cannot resize " + name);
+        }
+        map(name);
+#endif
+    }
+
+    //    ,    
+    SharedMapping(const std::string& name, Backing backing) : base(nullptr), length(0), fresh(false) {
+#ifdef _WIN32
+        file = INVALID_HANDLE_VALUE;
+        if (backing == Backing::File) {
+            file = CreateFileA(name.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+                throw std::runtime_error("cannot open " + name);
+            mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, 0, 0, nullptr);
+        }
+        else {
+            mapping = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, name.c_str());
+        }
+        map(name);
+        MEMORY_BASIC_INFORMATION info;
+        VirtualQuery(base, &info, sizeof(info));
+        length = info.RegionSize;
+#else
+        fd = backing == Backing::SharedMemory ? shm_open(name.c_str(), O_RDWR, 0) : open(name.c_str(), O_RDWR);
+        if (fd < 0)
+            throw std::runtime_error("cannot open " + name);
+        //      
+        struct stat info;
+        for (int attempt = 0; fstat(fd, &info) == 0 && info.st_size == 0 && attempt < 1000; ++attempt)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        length = static_cast<size_t>(info.st_size);
+        if (length == 0) {
+            close(fd);
+            throw std::runtime_error("empty shared object " + name);
+        }
+        map(name);
+#endif
+    }
+
+    //      
+    ~SharedMapping() {
+#ifdef _WIN32
+        UnmapViewOfFile(base);
+        CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE)
+            CloseHandle(file);
+#else
+        munmap(base, length);
+        close(fd);
+#endif
+    }
+
+    SharedMapping(const SharedMapping&) = delete;
+    SharedMapping& operator=(const SharedMapping&) = delete;
+
+    char* data() const { return base; }
+    size_t size() const { return length; }
+    bool created() const { return fresh; }
+
+    //  :         (flock,
+    //    Windows - LockFileEx    ).       ,
+    // ,      ,      .
+    // holdExclusive  : true -       ,   , 
+    // holdShared     .
+    bool holdExclusive() {
+#ifdef _WIN32
+        //    ,     :   
+        if (file == INVALID_HANDLE_VALUE)
+            return fresh;
+        OVERLAPPED at = sessionByte();
+        exclusive = LockFileEx(file, LOCKFILE_EXCLUSIVE_LOCK | LOCKFILE_FAIL_IMMEDIATELY, 0, 1, 0, &at) != 0;
+        return exclusive;
+#else
+        return flock(fd, LOCK_EX | LOCK_NB) == 0;
+#endif
+    }
+
+    void holdShared() {
+#ifdef _WIN32
+        if (file == INVALID_HANDLE_VALUE)
+            return;
+        OVERLAPPED at = sessionByte();
+        LockFileEx(file, 0, 0, 1, 0, &at);
+        if (exclusive) {
+            //      :    
+            at = sessionByte();
+            UnlockFileEx(file, 0, 1, 0, &at);
+            exclusive = false;
+        }
+#else
+        //       
+        while (flock(fd, LOCK_SH) != 0 && errno == EINTR) {}
+#endif
+    }
+
+    //      (     )
+    void flush() const {
+#ifdef _WIN32
+        FlushViewOfFile(base, 0);
+#else
+        msync(base, length, MS_SYNC);
+#endif
+    }
+
+    static void remove(const std::string& name, Backing backing) {
+#ifdef _WIN32
+        //   Windows    
+        if (backing == Backing::File)
+            DeleteFileA(name.c_str());
+#else
+        if (backing == Backing::SharedMemory)
+            shm_unlink(name.c_str());
+        else
+            unlink(name.c_str());
+#endif
+    }
+
+private:
+#ifdef _WIN32
+    //    :   ,    
+    void map(const std::string& name) {
+        if (mapping)
+            base = static_cast<char*>(MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0));
+        if (!base) {
+            if (mapping)
+                CloseHandle(mapping);
+            if (file != INVALID_HANDLE_VALUE)
+                CloseHandle(file);
+            throw std::runtime_error("cannot map " + name);
+        }
+    }
+
+    //    -     ,     
+    static OVERLAPPED sessionByte() {
+        OVERLAPPED at = {};
+        at.OffsetHigh = 0x7FFFFFFF;
+        return at;
+    }
+
+    HANDLE file;    //   (INVALID_HANDLE_VALUE   ),   
+    HANDLE mapping;
+    bool exclusive = false; //     
+#else
+    //   :    
+    void map(const std::string& name) {
+        void* address = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (address == MAP_FAILED) {
+            close(fd);
+            throw std::runtime_error("cannot map " + name);
+        }
+        base = static_cast<char*>(address);
+    }
+
+    int fd;         //  ,   
+#endif
+
+    char* base;
+    size_t length;
+    bool fresh;     //    
+};
+
+//     .   -   :  
+//    countr_zero   ,   Buddy::BestFit.
+class MemoryManager {
+public:
+    static const size_t kAlignment = 32;      //         ( -  )
+    static const uint64_t kNull = UINT64_MAX; //  
+
+private:
+    static const int kMinLevel = 5;           //   2^5 = kAlignment  ( FreeNode)
+    static const int kLevelCount = 64;
+    static const uint32_t kMagic = 0x42554444; // "BUDD" -  
+    static const uint32_t kVersion = 2;        //       
+    static const size_t kPage = 4096;          //     
+
+    //  :     -    
+    struct FreeNode {
+        uint64_t next;
+        uint64_t prev;
+    };
+
+    //    .       - 
+    //    ,   .   mappingSize  root
+    //             .
+    struct Header {
+        std::atomic<uint32_t> ready;     // kMagic,    
+        uint32_t version;
+        uint32_t sessions;               //   MemoryManager   
+        uint32_t reserved;
+        uint64_t checksum;               //       
+        uint64_t checkpoints;            //  
+        uint64_t mappingSize;            //   
+        uint64_t poolOffset;             //     
+        uint64_t bitmapOffset;           //      
+        uint64_t levelsOffset;           //       32- 
+        int32_t maxLevel;                //  - 2^maxLevel 
+        uint32_t padding;                //  :      
+        uint64_t levelMask;              // ,     
+        uint64_t freeLists[kLevelCount]; //   
+        uint64_t levelBase[kLevelCount]; //      
+        std::atomic<uint64_t> root;      //     
+#ifndef _WIN32
+        pthread_mutex_t mutex;           //  
+#endif
+    };
+
+    static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<uint64_t>::is_always_lock_free,
+                  "shared header needs address-free atomics");
+
+    SharedMapping mapping;  //   
+    Header* header;         //    
+    char* poolBegin;        //     
+    uint64_t* freeBits;     //   
+    uint8_t* levels;        //  
+#ifdef _WIN32
+    HANDLE mutex;           //  ,    
+#endif
+    Startup startupKind;    //      
+    mutable size_t abandonedCount; // ,    
+    mutable size_t rebuildCount;   //     
+    ALLOCATOR_STAT(Stats::Counters stats;) //    
+
+    //    
+    class Guard {
+    public:
+        explicit Guard(const MemoryManager& manager) : manager(manager) { manager.lock(); }
+        ~Guard() { manager.unlock(); }
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+    private:
+        const MemoryManager& manager;
+    };
+
+public:
+    //  :    ,   size; 
+    //       .  Open::Restore    
+    // (size   ):    ,      .
+    //       ,   -   .
+    MemoryManager(const std::string& name, size_t size, Backing backing = Backing::SharedMemory, Open open = Open::Replace)
+        : mapping(name, backing, layoutSize(checkedLevel(size)), open == Open::Replace), startupKind(Startup::Created), abandonedCount(0), rebuildCount(0) {
+        header = reinterpret_cast<Header*>(mapping.data());
+        if (mapping.created() || header->ready.load(std::memory_order_acquire) != kMagic) {
+            //     ,   
+            if (mapping.size() != layoutSize(topLevel(size)))
+                throw std::runtime_error("incompatible shared pool " + name);
+            format(name, topLevel(size));
+            mapping.holdShared();
+            return;
+        }
+        if (header->version != kVersion || header->mappingSize != mapping.size()
+            || header->maxLevel < kMinLevel || header->maxLevel >= kLevelCount - 1 || mapping.size() != layoutSize(header->maxLevel))
+            throw std::runtime_error("incompatible shared pool " + name);
+        attach(name);
+        if (mapping.holdExclusive()) {
+            //  :       ,    ( 
+            //   ),    -  ,    
+            initLock();
+            restore();
+            mapping.holdShared();
+            return;
+        }
+        //    :       ,   - 
+        //   ,    
+        mapping.holdShared();
+        startupKind = Startup::Resumed;
+        Guard guard(*this);
+        ++header->sessions;
+    }
+
+    //   ,    (   -   )
+    explicit MemoryManager(const std::string& name, Backing backing = Backing::SharedMemory)
+        : mapping(name, backing), startupKind(Startup::Resumed), abandonedCount(0), rebuildCount(0) {
+        //       Open::Restore,   
+        mapping.holdShared();
+        header = reinterpret_cast<Header*>(mapping.data());
+        for (int attempt = 0; header->ready.load(std::memory_order_acquire) != kMagic; ++attempt) {
+            if (attempt == 1000)
+                throw std::runtime_error("shared pool " + name + " is not initialized");
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        if (header->version != kVersion || header->mappingSize > mapping.size())
+            throw std::runtime_error("incompatible shared pool " + name);
+        attach(name);
+        Guard guard(*this);
+        ++header->sessions;
+    }
+
+    //       :     Open::Restore
+    //    
+    ~MemoryManager() {
+        bool last;
+        {
+            Guard guard(*this);
+            last = --header->sessions == 0;
+            if (last)
+                seal();
+        }
+        if (last)
+            mapping.flush();
+#ifdef _WIN32
+        CloseHandle(mutex);
+#endif
+        //   SharedMapping;     
+    }
+
+    MemoryManager(const MemoryManager&) = delete;
+    MemoryManager& operator=(const MemoryManager&) = delete;
+
+    static void remove(const std::string& name, Backing backing = Backing::SharedMemory) {
+        SharedMapping::remove(name, backing);
+    }
+
+    void* allocate(size_t size) {
+        int level = levelFor(size);
+        if (level > header->maxLevel)
+            return nullptr;
+
+        Guard guard(*this);
+        uint64_t candidates = header->levelMask & (~uint64_t(0) << level);
+        int l = candidates ? std::countr_zero(candidates) : -1;
+        ALLOCATOR_STAT(Stats::Probe probe; probe.steps = l < 0 ? 0 : static_cast<size_t>(l - level));
+        ALLOCATOR_STAT(stats.onAllocate(size, l < 0 ? 0 : size_t(1) << level, probe));
+        if (l < 0)
+            return nullptr;
+
+        uint64_t offset = popFree(l);
+        while (l > level) {
+            --l;
+            pushFree(offset + (uint64_t(1) << l), l);
+            ALLOCATOR_STAT(stats.onSplit());
+        }
+        levels[offset >> kMinLevel] = static_cast<uint8_t>(level);
+        return poolBegin + offset;
+    }
+
+    //   -     ,      
+    void deallocate(void* address) {
+        if (!address)
+            return;
+        uint64_t offset = offsetOf(address);
+        Guard guard(*this);
+        release(offset, levels[offset >> kMinLevel]);
+    }
+
+    void deallocate(void* address, size_t size) {
+        if (!address)
+            return;
+        uint64_t offset = offsetOf(address);
+        Guard guard(*this);
+        release(offset, levelFor(size));
+    }
+
+    uint64_t offsetOf(const void* address) const {
+        return address ? static_cast<uint64_t>(static_cast<const char*>(address) - poolBegin) : kNull;
+    }
+
+    void* addressOf(uint64_t offset) const {
+        return offset != kNull ? poolBegin + offset : nullptr;
+    }
+
+    void setRoot(uint64_t offset) { header->root.store(offset, std::memory_order_release); }
+    uint64_t root() const { return header->root.load(std::memory_order_acquire); }
+
+    size_t poolSize() const { return size_t(1) << header->maxLevel; }
+
+    size_t freeBytes() const {
+        size_t total = 0;
+        forEachFreeBlock([&](size_t size) { total += size; });
+        return total;
+    }
+
+    size_t largestFreeBlock() const {
+        Guard guard(*this);
+        uint64_t mask = header->levelMask;
+        return mask ? size_t(1) << (std::bit_width(mask) - 1) : 0;
+    }
+
+    //     , visit(size)  
+    template <class Visit>
+    void forEachFreeBlock(Visit visit) const {
+        Guard guard(*this);
+        for (int level = kMinLevel; level <= header->maxLevel; ++level) {
+            for (uint64_t offset = header->freeLists[level]; offset != kNull; offset = node(offset)->next)
+                visit(size_t(1) << level);
+        }
+    }
+
+    Startup startup() const { return startupKind; }
+    uint64_t checkpoints() const { return header->checkpoints; }
+    size_t abandonedLocks() const { return abandonedCount; }
+    size_t rebuilds() const { return rebuildCount; }
+
+    //   :    ,     ,
+    //   .      .
+    void checkpoint() {
+        {
+            Guard guard(*this);
+            seal();
+        }
+        mapping.flush();
+    }
+
+    CheckReport check() const {
+        Guard guard(*this);
+        return inspect();
+    }
+
+    //  ,         .   
+    //    :  ,    ,      
+    //     ( ,  ). ,   
+    //        ,   -  ,   .
+    //    .
+    CheckReport recover() {
+        Guard guard(*this);
+        rebuild();
+        return inspect();
+    }
+
+#ifdef ALLOCATOR_STATS
+    const Stats::Counters& counters() const { return stats; }
+#endif
+
+private:
+    //    2^maxLevel 
+    void format(const std::string& name, int maxLevel) {
+        if (!mapping.created())
+            std::memset(mapping.data(), 0, layoutSize(maxLevel) - (size_t(1) << maxLevel)); //    
+        header = new (mapping.data()) Header();
+        header->version = kVersion;
+        header->sessions = 1;
+        header->mappingSize = mapping.size();
+        header->maxLevel = maxLevel;
+        header->bitmapOffset = roundUp(sizeof(Header), sizeof(uint64_t));
+        header->levelsOffset = header->bitmapOffset + bitmapWords(maxLevel) * sizeof(uint64_t);
+        header->poolOffset = roundUp(header->levelsOffset + tableBytes(maxLevel), kPage);
+        header->levelMask = 0;
+        header->root.store(kNull, std::memory_order_relaxed);
+        size_t bits = 0;
+        for (int level = 0; level < kLevelCount; ++level) {
+            header->freeLists[level] = kNull;
+            header->levelBase[level] = bits;
+            if (level >= kMinLevel && level <= maxLevel)
+                bits += size_t(1) << (maxLevel - level);
+        }
+        attach(name);
+        initLock();
+        //    :      
+        pushFree(0, maxLevel);
+        header->ready.store(kMagic, std::memory_order_release);
+    }
+
+    //   :        ,
+    //       
+    void restore() {
+        header->sessions = 1;
+        if (header->checksum == metadataChecksum()) {
+            startupKind = Startup::Resumed;
+            return;
+        }
+        if (inspect().consistent) {
+            startupKind = Startup::Checked;
+            return;
+        }
+        rebuild();
+        startupKind = Startup::Recovered;
+    }
+
+    void attach(const std::string& name) {
+        char* base = mapping.data();
+        poolBegin = base + header->poolOffset;
+        freeBits = reinterpret_cast<uint64_t*>(base + header->bitmapOffset);
+        levels = reinterpret_cast<uint8_t*>(base + header->levelsOffset);
+#ifdef _WIN32
+        //       '\\' -     
+        std::string lockName = "Local\\SharedBuddy.";
+        for (char c : name)
+            lockName += c == '\\' || c == ':' || c == '/' ? '_' : c;
+        mutex = CreateMutexA(nullptr, FALSE, lockName.c_str());
+        if (!mutex)
+            throw std::runtime_error("cannot create lock for " + name);
+#else
+        (void)name;
+#endif
+    }
+
+    void initLock() {
+#ifndef _WIN32
+        pthread_mutexattr_t attributes;
+        pthread_mutexattr_init(&attributes);
+        pthread_mutexattr_setpshared(&attributes, PTHREAD_PROCESS_SHARED);
+#ifdef SHARED_BUDDY_ROBUST_MUTEX
+        // ,    ,     
+        pthread_mutexattr_setrobust(&attributes, PTHREAD_MUTEX_ROBUST);
+#endif
+        pthread_mutex_init(&header->mutex, &attributes);
+        pthread_mutexattr_destroy(&attributes);
+#endif
+    }
+
+    void lock() const {
+#ifdef _WIN32
+        // WAIT_ABANDONED -    ;   
+        if (WaitForSingleObject(mutex, INFINITE) == WAIT_ABANDONED)
+            repair();
+#else
+        int result = pthread_mutex_lock(&header->mutex);
+#ifdef SHARED_BUDDY_ROBUST_MUTEX
+        //       :   
+        //    ,    EOWNERDEAD
+        if (result == EOWNERDEAD) {
+            repair();
+            pthread_mutex_consistent(&header->mutex);
+        }
+#else
+        (void)result;
+#endif
+#endif
+    }
+
+    //     : ,      
+    //   ,          
+    //   .      ,     
+    // ,      (    ).
+    void repair() const {
+        ++abandonedCount;
+        if (inspect().consistent)
+            return;
+        const_cast<MemoryManager*>(this)->rebuild();
+        ++rebuildCount;
+    }
+
+    void unlock() const {
+#ifdef _WIN32
+        ReleaseMutex(mutex);
+#else
+        pthread_mutex_unlock(&header->mutex);
+#endif
+    }
+
+    //    level    "" (  )
+    void release(uint64_t offset, int level) {
+        ALLOCATOR_STAT(stats.onDeallocate(size_t(1) << level));
+        while (level < header->maxLevel) {
+            uint64_t buddyOffset = offset ^ (uint64_t(1) << level);
+            if (!testBit(level, buddyOffset))
+                break;
+            removeFree(buddyOffset, level);
+            offset &= ~(uint64_t(1) << level);
+            ++level;
+            ALLOCATOR_STAT(stats.onMerge());
+        }
+        pushFree(offset, level);
+    }
+
+    //   :    
+    void seal() {
+        ++header->checkpoints;
+        header->checksum = metadataChecksum();
+    }
+
+    //    (mappingSize..levelBase, root)       
+    uint64_t metadataChecksum() const {
+        const char* base = mapping.data();
+        size_t first = offsetof(Header, mappingSize);
+        uint64_t hash = checksum(base + first, offsetof(Header, root) - first, header->root.load(std::memory_order_relaxed));
+        return checksum(base + header->bitmapOffset, header->levelsOffset + tableBytes(header->maxLevel) - header->bitmapOffset, hash);
+    }
+
+    // 64- :    xxHash64  8 ,  - 
+    static uint64_t checksum(const char* data, size_t size, uint64_t seed) {
+        const uint64_t prime1 = 0x9E3779B185EBCA87ULL, prime2 = 0xC2B2AE3D27D4EB4FULL;
+        uint64_t lanes[4] = { seed + prime1, seed + prime2, seed, seed - prime1 };
+        size_t i = 0;
+        for (; i + 32 <= size; i += 32) {
+            for (int k = 0; k < 4; ++k) {
+                uint64_t word;
+                std::memcpy(&word, data + i + 8 * k, sizeof(word));
+                lanes[k] = std::rotl(lanes[k] + word * prime2, 31) * prime1;
+            }
+        }
+        uint64_t hash = std::rotl(lanes[0], 1) + std::rotl(lanes[1], 7) + std::rotl(lanes[2], 12) + std::rotl(lanes[3], 18) + size;
+        for (; i < size; ++i)
+            hash = (hash ^ static_cast<unsigned char>(data[i])) * prime1;
+        return hash;
+    }
+
+    //    ,   offset,   ; -1 -  
+    int freeLevelAt(uint64_t offset) const {
+        int top = offset ? std::min(std::countr_zero(offset), static_cast<int>(header->maxLevel)) : header->maxLevel;
+        for (int level = top; level >= kMinLevel; --level) {
+            if (testBit(level, offset))
+                return level;
+        }
+        return -1;
+    }
+
+    //     offset   ; -1 -     
+    int allocatedLevelAt(uint64_t offset) const {
+        int level = levels[offset >> kMinLevel];
+        if (level < kMinLevel || level > header->maxLevel || (offset & ((uint64_t(1) << level) - 1)))
+            return -1;
+        return level;
+    }
+
+    //      
+    size_t markedBlocks(int level) const {
+        size_t bit = header->levelBase[level], end = bit + (size_t(1) << (header->maxLevel - level));
+        size_t count = 0;
+        while (bit < end) {
+            if (bit % 64 == 0 && bit + 64 <= end) {
+                count += static_cast<size_t>(std::popcount(freeBits[bit / 64]));
+                bit += 64;
+            }
+            else {
+                count += (freeBits[bit / 64] >> (bit % 64)) & 1u;
+                ++bit;
+            }
+        }
+        return count;
+    }
+
+    //   .         ,
+    //         ( )   ( 
+    // ) :   ,  "" ,   .
+    CheckReport inspect() const {
+        CheckReport report;
+        auto fail = [&report](const char* problem) {
+            if (report.consistent) {
+                report.consistent = false;
+                report.problem = problem;
+            }
+        };
+        uint64_t poolBytes = uint64_t(1) << header->maxLevel;
+        size_t listedBytes = 0;
+        for (int level = kMinLevel; level <= header->maxLevel; ++level) {
+            size_t count = 0, limit = size_t(1) << (header->maxLevel - level);
+            uint64_t prev = kNull;
+            for (uint64_t offset = header->freeLists[level]; offset != kNull; offset = node(offset)->next) {
+                if (offset >= poolBytes || (offset & ((uint64_t(1) << level) - 1))) {
+                    fail("free list points outside the pool");
+                    break;
+                }
+                if (!testBit(level, offset))
+                    fail("free block is not marked in the bitmap");
+                if (node(offset)->prev != prev)
+                    fail("free list links are broken");
+                if (++count > limit) {
+                    fail("free list loops");
+                    break;
+                }
+                prev = offset;
+            }
+            if (((header->levelMask >> level) & 1u) != (count != 0 ? 1u : 0u))
+                fail("level mask does not match free lists");
+            if (markedBlocks(level) != count)
+                fail("bitmap does not match free lists");
+            listedBytes += count << level;
+        }
+
+        for (uint64_t offset = 0; offset < poolBytes; ) {
+            int level = freeLevelAt(offset);
+            if (level >= 0) {
+                if (level < header->maxLevel && testBit(level, offset ^ (uint64_t(1) << level)))
+                    fail("free buddies are not merged");
+                ++report.freeBlocks;
+                report.freeBytes += size_t(1) << level;
+            }
+            else if ((level = allocatedLevelAt(offset)) >= 0) {
+                ++report.allocatedBlocks;
+                report.allocatedBytes += size_t(1) << level;
+            }
+            else {
+                fail("level table is damaged");
+                level = kMinLevel;
+                report.lostBytes += size_t(1) << level;
+            }
+            offset += uint64_t(1) << level;
+        }
+        if (report.freeBytes != listedBytes)
+            fail("free blocks overlap");
+        return report;
+    }
+
+    //   :   -      , 
+    //    .         32  
+    // :        ,   .
+    void rebuild() {
+        uint64_t poolBytes = uint64_t(1) << header->maxLevel;
+        std::vector<std::pair<uint64_t, int>> freeBlocks;
+        for (uint64_t offset = 0; offset < poolBytes; ) {
+            int level = freeLevelAt(offset);
+            if (level < 0 && (level = allocatedLevelAt(offset)) >= 0) {
+                offset += uint64_t(1) << level;
+                continue;
+            }
+            if (level < 0)
+                level = kMinLevel;
+            //     :  ""   ,    
+            uint64_t start = offset;
+            offset += uint64_t(1) << level;
+            while (!freeBlocks.empty() && level < header->maxLevel && freeBlocks.back().second == level
+                   && freeBlocks.back().first == (start ^ (uint64_t(1) << level))) {
+                start = freeBlocks.back().first;
+                freeBlocks.pop_back();
+                ++level;
+            }
+            freeBlocks.emplace_back(start, level);
+        }
+        std::memset(freeBits, 0, bitmapWords(header->maxLevel) * sizeof(uint64_t));
+        for (int level = 0; level < kLevelCount; ++level)
+            header->freeLists[level] = kNull;
+        header->levelMask = 0;
+        for (const auto& block : freeBlocks)
+            pushFree(block.first, block.second);
+    }
+
+    //    size;      
+    static int checkedLevel(size_t size) {
+        int level = topLevel(size);
+        if (level < kMinLevel)
+            throw std::invalid_argument("shared pool is too small");
+        return level;
+    }
+
+    //     2^maxLevel: , ,  ,    
+    static size_t layoutSize(int maxLevel) {
+        size_t metadata = roundUp(sizeof(Header), sizeof(uint64_t)) + bitmapWords(maxLevel) * sizeof(uint64_t) + tableBytes(maxLevel);
+        return roundUp(metadata, kPage) + (size_t(1) << maxLevel);
+    }
+
+    static size_t roundUp(size_t value, size_t granularity) {
+        return (value + granularity - 1) / granularity * granularity;
+    }
+
+    static size_t tableBytes(int level) {
+        return size_t(1) << (level - kMinLevel);
+    }
+
+    static int topLevel(size_t size) {
+        return size ? static_cast<int>(std::bit_width(size)) - 1 : 0;
+    }
+
+    static size_t bitmapWords(int level) {
+        return ((size_t(1) << (level - kMinLevel + 1)) + 63) / 64;
+    }
+
+    static int levelFor(size_t size) {
+        if (size <= (size_t(1) << kMinLevel))
+            return kMinLevel;
+        return static_cast<int>(std::bit_width(size - 1));
+    }
+
+    FreeNode* node(uint64_t offset) const {
+        return reinterpret_cast<FreeNode*>(poolBegin + offset);
+    }
+
+    size_t bitIndex(uint64_t offset, int level) const {
+        return header->levelBase[level] + static_cast<size_t>(offset >> level);
+    }
+
+    bool testBit(int level, uint64_t offset) const {
+        size_t bit = bitIndex(offset, level);
+        return (freeBits[bit / 64] >> (bit % 64)) & 1u;
+    }
+
+    void setBit(int level, uint64_t offset, bool value) {
+        size_t bit = bitIndex(offset, level);
+        if (value) freeBits[bit / 64] |= uint64_t(1) << (bit % 64);
+        else freeBits[bit / 64] &= ~(uint64_t(1) << (bit % 64));
+    }
+
+    void pushFree(uint64_t offset, int level) {
+        FreeNode* block = node(offset);
+        block->prev = kNull;
+        block->next = header->freeLists[level];
+        if (block->next != kNull) node(block->next)->prev = offset;
+        header->freeLists[level] = offset;
+        setBit(level, offset, true);
+        header->levelMask |= uint64_t(1) << level;
+    }
+
+    uint64_t popFree(int level) {
+        uint64_t offset = header->freeLists[level];
+        removeFree(offset, level);
+        return offset;
+    }
+
+    void removeFree(uint64_t offset, int level) {
+        FreeNode* block = node(offset);
+        if (block->prev != kNull) node(block->prev)->next = block->next;
+        else header->freeLists[level] = block->next;
+        if (block->next != kNull) node(block->next)->prev = block->prev;
+        setBit(level, offset, false);
+        if (header->freeLists[level] == kNull)
+            header->levelMask &= ~(uint64_t(1) << level);
+    }
+};
+
+} // namespace SharedBuddy
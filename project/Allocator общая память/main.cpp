@@ -0,0 +1,318 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <atomic>
+#include <cstring>
+#include <cstdlib>
+#include <cassert>
+#include <cstdint>
+#include <filesystem>
+#include "SharedBuddy.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <csignal>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using SharedBuddy::Backing;
+using SharedBuddy::MemoryManager;
+
+static const int kProducers = 4;
+static const int kMessages = 64;        //    
+static const size_t kMinPayload = 256 * 1024;
+static const size_t kMaxPayload = 1024 * 1024;
+
+//    :        .     .
+struct Message {
+    std::atomic<uint64_t> offset; // kNull -   
+    uint64_t size;
+};
+
+static unsigned char pattern(int producer, int message) {
+    return static_cast<unsigned char>(producer * 31 + message + 1);
+}
+
+//    :      (   ),
+//  ,     .   -   
+// ,      .   - ,   .
+static int runProducer(const std::string& name, Backing backing, int producer) {
+    MemoryManager pool(name, backing);
+    Message* mailbox = static_cast<Message*>(pool.addressOf(pool.root()));
+    std::mt19937 rng(producer + 1);
+    std::vector<void*> scratch;
+    for (int message = 0; message < kMessages; ++message) {
+        size_t size = kMinPayload + rng() % (kMaxPayload - kMinPayload);
+        void* buffer;
+        while (!(buffer = pool.allocate(size)))
+            std::this_thread::yield();
+        std::memset(buffer, pattern(producer, message), size);
+
+        for (int i = 0; i < 64; ++i) {
+            void* small = pool.allocate(16 + rng() % 1024);
+            if (small)
+                scratch.push_back(small);
+            if (scratch.size() > 32) {
+                pool.deallocate(scratch.front());
+                scratch.erase(scratch.begin());
+            }
+        }
+
+        Message& slot = mailbox[producer * kMessages + message];
+        slot.size = size;
+        slot.offset.store(pool.offsetOf(buffer), std::memory_order_release);
+    }
+    for (void* small : scratch)
+        pool.deallocate(small);
+    return 0;
+}
+
+#ifdef _WIN32
+//  Windows  fork:  -       "producer <> <?> <>"
+static HANDLE spawnProducer(const std::string& name, Backing backing, int producer) {
+    char path[MAX_PATH];
+    GetModuleFileNameA(nullptr, path, MAX_PATH);
+    std::string command = "\"" + std::string(path) + "\" producer \"" + name + "\" " + (backing == Backing::File ? "1 " : "0 ") + std::to_string(producer);
+    STARTUPINFOA startup = { sizeof(startup) };
+    PROCESS_INFORMATION process;
+    if (!CreateProcessA(nullptr, &command[0], nullptr, nullptr, FALSE, 0, nullptr, nullptr, &startup, &process))
+        return nullptr;
+    CloseHandle(process.hThread);
+    return process.hProcess;
+}
+#endif
+
+//  -  :        , 
+//    (   ,  ).  false   .
+static bool runExchange(const std::string& name, Backing backing) {
+    using Clock = std::chrono::steady_clock;
+    MemoryManager pool(name, 64 * 1024 * 1024, backing);
+    size_t initialFree = pool.freeBytes();
+
+    //             ,
+    //      -     
+    {
+        MemoryManager other(name, backing);
+        void* block = pool.allocate(100);
+        std::strcpy(static_cast<char*>(block), "offset");
+        char* seen = static_cast<char*>(other.addressOf(pool.offsetOf(block)));
+        assert(seen != block && std::strcmp(seen, "offset") == 0);
+        other.deallocate(seen);
+        assert(pool.freeBytes() == initialFree);
+    }
+
+    const size_t messages = size_t(kProducers) * kMessages;
+    Message* mailbox = static_cast<Message*>(pool.allocate(messages * sizeof(Message)));
+    for (size_t i = 0; i < messages; ++i) {
+        new (&mailbox[i].offset) std::atomic<uint64_t>(MemoryManager::kNull);
+        mailbox[i].size = 0;
+    }
+    pool.setRoot(pool.offsetOf(mailbox));
+
+    auto start = Clock::now();
+#ifdef _WIN32
+    std::vector<HANDLE> children;
+    for (int producer = 0; producer < kProducers; ++producer)
+        children.push_back(spawnProducer(name, backing, producer));
+#else
+    std::vector<pid_t> children;
+    for (int producer = 0; producer < kProducers; ++producer) {
+        pid_t child = fork();
+        if (child == 0)
+            _exit(runProducer(name, backing, producer));
+        children.push_back(child);
+    }
+#endif
+
+    bool intact = true;
+    size_t received = 0, bytes = 0;
+    std::vector<bool> done(messages, false);
+    while (received < messages) {
+        bool progress = false;
+        for (size_t i = 0; i < messages; ++i) {
+            uint64_t offset = done[i] ? MemoryManager::kNull : mailbox[i].offset.load(std::memory_order_acquire);
+            if (offset == MemoryManager::kNull)
+                continue;
+            const unsigned char* data = static_cast<const unsigned char*>(pool.addressOf(offset));
+            unsigned char expected = pattern(static_cast<int>(i / kMessages), static_cast<int>(i % kMessages));
+            for (size_t k = 0; k < mailbox[i].size; k += 4096)
+                intact = intact && data[k] == expected;
+            intact = intact && data[mailbox[i].size - 1] == expected;
+            bytes += mailbox[i].size;
+            pool.deallocate(pool.addressOf(offset));
+            done[i] = true;
+            ++received;
+            progress = true;
+        }
+        if (!progress)
+            std::this_thread::yield();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+#ifdef _WIN32
+    for (HANDLE child : children) {
+        DWORD code = 1;
+        WaitForSingleObject(child, INFINITE);
+        GetExitCodeProcess(child, &code);
+        intact = intact && code == 0;
+        CloseHandle(child);
+    }
+#else
+    for (pid_t child : children) {
+        int status = 0;
+        waitpid(child, &status, 0);
+        intact = intact && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+#endif
+    pool.deallocate(mailbox);
+    intact = intact && pool.freeBytes() == initialFree && pool.largestFreeBlock() == pool.poolSize();
+
+    std::cout << std::left << std::setw(16) << (backing == Backing::File ? "file" : "shared memory") << std::right
+              << std::setw(10) << kProducers << std::setw(10) << received << std::fixed << std::setprecision(1)
+              << std::setw(12) << bytes / (1024.0 * 1024.0) << std::setw(12) << bytes / seconds / (1024.0 * 1024.0 * 1024.0)
+              << std::setw(8) << (intact ? "ok" : "FAIL") << std::endl;
+    MemoryManager::remove(name, backing);
+    return intact;
+}
+
+#ifndef _WIN32
+//  ,   ;   ,    
+struct Tally {
+    std::atomic<uint32_t> stop;
+    std::atomic<uint64_t> operations;
+    std::atomic<uint64_t> corrupted;      // ,  - ,     
+    std::atomic<uint64_t> abandonedLocks; // ,    
+    std::atomic<uint64_t> rebuilds;       //   -   
+};
+
+static const int kSurvivors = 2;
+static const int kVictims = 200;
+
+//  :  ,        
+//  .         ,  
+//    .
+static int runSurvivor(const std::string& name, int survivor) {
+    MemoryManager pool(name);
+    Tally* tally = static_cast<Tally*>(pool.addressOf(pool.root()));
+    std::mt19937 rng(survivor + 100);
+    std::vector<std::pair<unsigned char*, size_t>> window(64, { nullptr, 0 });
+    uint64_t operations = 0, corrupted = 0;
+    while (!tally->stop.load(std::memory_order_acquire)) {
+        auto& slot = window[rng() % window.size()];
+        unsigned char stamp = static_cast<unsigned char>(survivor * 64 + (&slot - window.data()) + 1);
+        if (slot.first) {
+            for (size_t i = 0; i < slot.second; ++i)
+                corrupted += slot.first[i] != stamp ? 1 : 0;
+            pool.deallocate(slot.first);
+        }
+        slot.second = 32 + rng() % 4096;
+        slot.first = static_cast<unsigned char*>(pool.allocate(slot.second));
+        if (slot.first)
+            std::memset(slot.first, stamp, slot.second);
+        ++operations;
+    }
+    for (auto& slot : window)
+        pool.deallocate(slot.first);
+    tally->operations += operations;
+    tally->corrupted += corrupted;
+    tally->abandonedLocks += pool.abandonedLocks();
+    tally->rebuilds += pool.rebuilds();
+    return 0;
+}
+
+// :     (     )   
+// ,     SIGKILL -    . Ÿ   .
+static void runVictim(const std::string& name, unsigned seed, int ready) {
+    MemoryManager pool(name);
+    std::mt19937 rng(seed);
+    std::vector<void*> window(32, nullptr);
+    for (size_t operation = 0; ; ++operation) {
+        void*& slot = window[rng() % window.size()];
+        pool.deallocate(slot);
+        size_t size = 32 + rng() % 4096;
+        slot = pool.allocate(size);
+        if (slot)
+            std::memset(slot, 0xEE, std::min<size_t>(size, 64));
+        if (operation == 256 && write(ready, "r", 1) != 1)
+            _exit(1);
+    }
+}
+
+//   :  ,        .
+// ,   ,  ,       .
+static bool runCrashes(const std::string& name) {
+    MemoryManager pool(name, 64 * 1024 * 1024);
+    Tally* tally = new (pool.allocate(sizeof(Tally))) Tally{};
+    pool.setRoot(pool.offsetOf(tally));
+
+    std::vector<pid_t> survivors;
+    for (int survivor = 0; survivor < kSurvivors; ++survivor) {
+        pid_t child = fork();
+        if (child == 0)
+            _exit(runSurvivor(name, survivor));
+        survivors.push_back(child);
+    }
+    int killed = 0;
+    for (int victim = 0; victim < kVictims; ++victim) {
+        int ready[2];
+        if (pipe(ready) != 0)
+            break;
+        pid_t child = fork();
+        if (child == 0)
+            runVictim(name, static_cast<unsigned>(victim + 1), ready[1]);
+        char signal;
+        bool started = read(ready[0], &signal, 1) == 1;
+        close(ready[0]);
+        close(ready[1]);
+        std::this_thread::sleep_for(std::chrono::microseconds(victim * 7919 % 2000));
+        kill(child, SIGKILL);
+        int status = 0;
+        waitpid(child, &status, 0);
+        killed += started && WIFSIGNALED(status) ? 1 : 0;
+    }
+    tally->stop.store(1, std::memory_order_release);
+    bool intact = killed == kVictims;
+    for (pid_t child : survivors) {
+        int status = 0;
+        waitpid(child, &status, 0);
+        intact = intact && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+    tally->abandonedLocks += pool.abandonedLocks();
+    tally->rebuilds += pool.rebuilds();
+    SharedBuddy::CheckReport check = pool.check();
+    intact = intact && tally->corrupted == 0 && check.consistent;
+    std::cout << killed << " processes killed while " << kSurvivors << " kept allocating (" << tally->operations
+              << " ops): " << tally->abandonedLocks << " locks taken from a dead owner, " << tally->rebuilds
+              << " metadata rebuilds, " << tally->corrupted << " corrupted bytes, check "
+              << (check.consistent ? "ok" : check.problem) << std::endl;
+    MemoryManager::remove(name);
+    return intact;
+}
+#endif
+
+int main(int argc, char** argv) {
+    if (argc == 5 && std::strcmp(argv[1], "producer") == 0)
+        return runProducer(argv[2], std::atoi(argv[3]) ? Backing::File : Backing::SharedMemory, std::atoi(argv[4]));
+
+    //    256KB-1MB    64MB,     .
+    // GB/s - ,   ,    .
+    std::cout << std::left << std::setw(16) << "backing" << std::right << std::setw(10) << "procs" << std::setw(10) << "buffers"
+              << std::setw(12) << "MB" << std::setw(12) << "GB/s" << std::setw(8) << "check" << std::endl;
+#ifdef _WIN32
+    std::string sharedName = "Local\\SharedBuddyDemo";
+#else
+    std::string sharedName = "/shared-buddy-demo";
+#endif
+    bool ok = runExchange(sharedName, Backing::SharedMemory);
+    ok = runExchange((std::filesystem::temp_directory_path() / "shared-buddy-demo.pool").string(), Backing::File) && ok;
+#ifndef _WIN32
+    ok = runCrashes("/shared-buddy-crash") && ok;
+#endif
+    return ok ? 0 : 1;
+}
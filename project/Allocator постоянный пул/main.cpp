@@ -0,0 +1,238 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <random>
+#include <cstring>
+#include <cstdio>
+#include <cassert>
+#include <cstdint>
+#include <filesystem>
+#include "SharedBuddy.h"
+
+#ifndef _WIN32
+#include <csignal>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using SharedBuddy::Backing;
+using SharedBuddy::MemoryManager;
+using SharedBuddy::Open;
+using SharedBuddy::Startup;
+using Clock = std::chrono::steady_clock;
+
+static const size_t kPoolSize = 256 * 1024 * 1024;
+static const size_t kEntries = 200000;
+static const size_t kScratch = 256;
+
+//   :    ,     
+struct Entry {
+    uint32_t key;
+    uint32_t length; //    
+};
+
+//       :      
+struct Directory {
+    uint64_t count;
+    uint64_t scratch[kScratch]; //     kNull
+    uint64_t entries[1];        // count 
+};
+
+static double millisecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static const char* startupName(Startup startup) {
+    switch (startup) {
+    case Startup::Created: return "created";
+    case Startup::Resumed: return "resumed";
+    case Startup::Checked: return "checked";
+    case Startup::Recovered: return "recovered";
+    }
+    return "?";
+}
+
+//      -      
+static size_t entryText(uint32_t key, char* text) {
+    size_t length = 0;
+    uint32_t value = key * 2654435761u;
+    size_t words = 4 + key % 60;
+    for (size_t word = 0; word < words; ++word) {
+        length += std::snprintf(text + length, 16, "%08x ", value);
+        value = value * 1664525u + 1013904223u;
+    }
+    return length;
+}
+
+//  :    
+static void build(MemoryManager& pool) {
+    Directory* directory = static_cast<Directory*>(pool.allocate(sizeof(Directory) + kEntries * sizeof(uint64_t)));
+    directory->count = kEntries;
+    for (size_t slot = 0; slot < kScratch; ++slot)
+        directory->scratch[slot] = MemoryManager::kNull;
+    char text[1024];
+    for (uint32_t key = 0; key < kEntries; ++key) {
+        size_t length = entryText(key, text);
+        Entry* entry = static_cast<Entry*>(pool.allocate(sizeof(Entry) + length));
+        entry->key = key;
+        entry->length = static_cast<uint32_t>(length);
+        std::memcpy(entry + 1, text, length);
+        directory->entries[key] = pool.offsetOf(entry);
+    }
+    pool.setRoot(pool.offsetOf(directory));
+}
+
+//    :        
+static bool verify(const MemoryManager& pool) {
+    const Directory* directory = static_cast<const Directory*>(pool.addressOf(pool.root()));
+    if (!directory || directory->count != kEntries)
+        return false;
+    char text[1024];
+    for (uint32_t key = 0; key < kEntries; ++key) {
+        const Entry* entry = static_cast<const Entry*>(pool.addressOf(directory->entries[key]));
+        size_t length = entryText(key, text);
+        if (entry->key != key || entry->length != length || std::memcmp(entry + 1, text, length) != 0)
+            return false;
+    }
+    return true;
+}
+
+static void report(const char* phase, const MemoryManager& pool, double openMs, double verifyMs, bool intact) {
+    SharedBuddy::CheckReport check = pool.check();
+    std::cout << std::left << std::setw(14) << phase << std::setw(11) << startupName(pool.startup()) << std::right
+              << std::fixed << std::setprecision(2) << std::setw(11) << openMs << std::setw(11) << verifyMs
+              << std::setw(12) << check.allocatedBytes / 1024 << std::setw(10) << check.lostBytes
+              << std::setw(8) << (check.consistent ? "ok" : check.problem) << std::setw(8) << (intact ? "ok" : "FAIL") << std::endl;
+}
+
+#ifndef _WIN32
+// -:  ,          SIGKILL
+//      -     
+static int crashRound(const std::string& path, unsigned seed) {
+    int ready[2];
+    if (pipe(ready) != 0)
+        return 1;
+    pid_t child = fork();
+    if (child == 0) {
+        MemoryManager pool(path, kPoolSize, Backing::File, Open::Restore);
+        Directory* directory = static_cast<Directory*>(pool.addressOf(pool.root()));
+        std::mt19937 rng(seed);
+        for (size_t operation = 0; ; ++operation) {
+            //          : 
+            //       
+            uint64_t& slot = directory->scratch[rng() % kScratch];
+            void* old = pool.addressOf(slot);
+            slot = MemoryManager::kNull;
+            pool.deallocate(old);
+            slot = pool.offsetOf(pool.allocate(32 + rng() % (rng() % 16 ? 8192 : 4 * 1024 * 1024)));
+            if (operation == kScratch && write(ready[1], "r", 1) != 1)
+                _exit(1);
+        }
+    }
+    char signal;
+    bool started = read(ready[0], &signal, 1) == 1;
+    close(ready[0]);
+    close(ready[1]);
+    std::this_thread::sleep_for(std::chrono::microseconds(seed * 7919 % 10000));
+    kill(child, SIGKILL);
+    int status = 0;
+    waitpid(child, &status, 0);
+    return started && WIFSIGNALED(status) ? 0 : 1;
+}
+#endif
+
+int main() {
+    std::string path = (std::filesystem::temp_directory_path() / "persistent-buddy.pool").string();
+    std::cout << "pool " << kPoolSize / (1024 * 1024) << "MB in " << path << ", " << kEntries << " cached entries" << std::endl;
+    std::cout << std::left << std::setw(14) << "phase" << std::setw(11) << "startup" << std::right << std::setw(11) << "open ms"
+              << std::setw(11) << "verify ms" << std::setw(12) << "used KB" << std::setw(10) << "lost B"
+              << std::setw(8) << "check" << std::setw(8) << "cache" << std::endl;
+    bool ok = true;
+
+    //  :    ;   
+    {
+        auto start = Clock::now();
+        MemoryManager pool(path, kPoolSize, Backing::File, Open::Replace);
+        build(pool);
+        double buildMs = millisecondsSince(start);
+        report("cold build", pool, buildMs, 0, true);
+        ok = ok && pool.startup() == Startup::Created;
+    }
+
+    //   :     
+    {
+        auto start = Clock::now();
+        MemoryManager pool(path, kPoolSize, Backing::File, Open::Restore);
+        double openMs = millisecondsSince(start);
+        start = Clock::now();
+        bool intact = verify(pool);
+        report("warm restart", pool, openMs, millisecondsSince(start), intact);
+        ok = ok && intact && pool.startup() == Startup::Resumed;
+
+        //   ,  :        
+        pool.checkpoint();
+    }
+
+#ifndef _WIN32
+    //  :      ,  
+    //       .     .
+    const int kRounds = 24;
+    int kinds[4] = {};
+    for (int round = 0; round < kRounds; ++round) {
+        ok = crashRound(path, static_cast<unsigned>(round + 1)) == 0 && ok;
+        auto start = Clock::now();
+        MemoryManager pool(path, kPoolSize, Backing::File, Open::Restore);
+        double openMs = millisecondsSince(start);
+        ++kinds[static_cast<int>(pool.startup())];
+        Directory* directory = static_cast<Directory*>(pool.addressOf(pool.root()));
+        for (uint64_t& slot : directory->scratch) {
+            pool.deallocate(pool.addressOf(slot));
+            slot = MemoryManager::kNull;
+        }
+        SharedBuddy::CheckReport check = pool.check();
+        bool intact = verify(pool);
+        ok = ok && intact && check.consistent && pool.startup() != Startup::Resumed && pool.startup() != Startup::Created;
+        if (round + 1 == kRounds || (pool.startup() == Startup::Recovered && kinds[static_cast<int>(Startup::Recovered)] == 1)) {
+            start = Clock::now();
+            intact = verify(pool);
+            report(round + 1 == kRounds ? "last crash" : "first recover", pool, openMs, millisecondsSince(start), intact);
+        }
+    }
+    std::cout << kRounds << " crashes: " << kinds[static_cast<int>(Startup::Checked)] << " checked, "
+              << kinds[static_cast<int>(Startup::Recovered)] << " recovered" << std::endl;
+#endif
+
+    // Open::Restore,      :    -  
+    // ,    ,     
+    {
+        uint64_t checkpoints = 0;
+        bool attached = false;
+        {
+            MemoryManager first(path, kPoolSize, Backing::File, Open::Restore);
+            MemoryManager second(path, Backing::File);
+            checkpoints = first.checkpoints();
+            {
+                MemoryManager late(path, kPoolSize, Backing::File, Open::Restore);
+                attached = late.startup() == Startup::Resumed && verify(late) && late.check().consistent;
+            }
+            attached = attached && first.checkpoints() == checkpoints && second.check().consistent;
+        }
+        MemoryManager pool(path, kPoolSize, Backing::File, Open::Restore);
+        attached = attached && pool.checkpoints() == checkpoints + 1 && pool.startup() == Startup::Resumed;
+        std::cout << "restore while 2 sessions are open: " << (attached ? "attached, one snapshot on the last close" : "FAIL") << std::endl;
+        ok = ok && attached;
+    }
+
+    //          
+    {
+        MemoryManager pool(path, kPoolSize, Backing::File, Open::Restore);
+        SharedBuddy::CheckReport before = pool.check();
+        SharedBuddy::CheckReport after = pool.recover();
+        ok = ok && before.consistent && after.consistent && before.freeBytes == after.freeBytes && verify(pool);
+    }
+    MemoryManager::remove(path, Backing::File);
+    std::cout << (ok ? "ok" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,322 @@
+//Checked::CheckedHeap<Manager> :      ( ,  ,  , ).    -   ,    ,   - .          ,   ,          .
+//Checked::Options :  ,   ,     ,  .
+//Checked::Violation : :     ,  ,    ,    ,    .
+//allocate(size_t size) :      ;   guardThreshold  -   ,    -  .
+//deallocate(void* address) / deallocate(void* address, size_t size) :      :     ,      ,    ,      .
+//drain() :       .
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <new>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "VirtualMemory.h"
+
+namespace Checked {
+
+enum class Problem {
+    BadHeader,     //        
+    DoubleFree,    //       
+    SizeMismatch,  //        
+    Overflow,      //     
+    UseAfterFree   //   ,    
+};
+
+struct Violation {
+    Problem problem;
+    const void* address; //   
+    size_t size;         //    ; 0 -  
+};
+
+//   :     -     
+inline void abortOnViolation(const Violation& violation) {
+    static const char* names[] = { "bad header or foreign pointer", "double free", "size mismatch", "buffer overflow", "use after free" };
+    std::fprintf(stderr, "checked heap: %s at %p (size %zu)\n", names[static_cast<int>(violation.problem)], violation.address, violation.size);
+    std::abort();
+}
+
+//   .    -     ,  
+//     1MB;    (     ).
+struct Options {
+    size_t quarantineBytes = size_t(1) << 20; //      
+    size_t quarantineBlocks = 4096;           //     ; 0 -  
+    size_t guardThreshold = 0;                //     -     ; 0 - 
+    size_t poisonBytes = 64;                  //        
+    void (*onViolation)(const Violation&) = abortOnViolation; //    ,  :    
+};
+
+template <class Manager>
+class CheckedHeap {
+private:
+    static const uint32_t kLive = 0xA110CA7E;   //   
+    static const uint32_t kFreed = 0xF4EEB10C;  //    
+    static const unsigned char kPoison = 0xDD;  //   
+    static const unsigned char kSlack = 0xFD;   //     
+
+    //   .    ,    :  
+    // ,           .    
+    //  -    ,  .    -   .
+    struct Header {
+        uint64_t size;
+        uint32_t state;
+        uint32_t reserved;
+        uint64_t check;
+    };
+
+    static const size_t kAlignment = Manager::kAlignment;
+    static const size_t kHeader = (sizeof(Header) + kAlignment - 1) / kAlignment * kAlignment; //     
+    static const size_t kFooter = sizeof(uint64_t);
+
+    //    .    :     
+    //     ,     .
+    struct GuardedBlock {
+        std::unique_ptr<VirtualMemory::Region> region;
+        size_t size;
+        bool freed;
+    };
+
+    //   
+    struct Quarantined {
+        char* data;
+        size_t size;
+        uint64_t check;  //  ;      - 0
+        bool guarded;
+    };
+
+    Manager manager;                 // ,      
+    Options options;
+    uint64_t secret;                 //     
+    std::vector<Quarantined> quarantine; //  -   quarantineBlocks    
+    size_t quarantineHead;           //  
+    size_t quarantineCount;
+    size_t quarantinedBytes;
+    std::unordered_map<const void*, GuardedBlock> guardedBlocks; //       
+    size_t violationCount;
+
+public:
+    //   options    ( ,  )
+    template <class... Args>
+    explicit CheckedHeap(const Options& options, Args&&... args)
+        : manager(std::forward<Args>(args)...), options(options), quarantine(options.quarantineBlocks),
+          quarantineHead(0), quarantineCount(0), quarantinedBytes(0), violationCount(0) {
+        secret = mix(reinterpret_cast<uintptr_t>(this) ^ static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count()));
+    }
+
+    //     ;       
+    ~CheckedHeap() {
+        drain();
+    }
+
+    CheckedHeap(const CheckedHeap&) = delete;
+    CheckedHeap& operator=(const CheckedHeap&) = delete;
+
+    void* allocate(size_t size) {
+        if (size == 0 || size > SIZE_MAX / 2)
+            return nullptr;
+        if (options.guardThreshold && size >= options.guardThreshold)
+            return allocateGuarded(size);
+
+        char* base = static_cast<char*>(manager.allocate(kHeader + size + kFooter));
+        if (!base && quarantineCount) {
+            //    -    ,  
+            drain();
+            base = static_cast<char*>(manager.allocate(kHeader + size + kFooter));
+        }
+        if (!base)
+            return nullptr;
+        char* data = base + kHeader;
+        Header* header = headerOf(data);
+        header->size = size;
+        header->state = kLive;
+        header->reserved = 0;
+        header->check = checkOf(data, size);
+        std::memcpy(data + size, &header->check, sizeof(header->check));
+        return data;
+    }
+
+    void deallocate(void* address) {
+        release(address, nullptr);
+    }
+
+    void deallocate(void* address, size_t size) {
+        release(address, &size);
+    }
+
+    void drain() {
+        while (quarantineCount)
+            evict();
+    }
+
+    size_t quarantined() const { return quarantineCount; }
+    size_t violations() const { return violationCount; }
+    Manager& underlying() { return manager; }
+    const Manager& underlying() const { return manager; }
+
+private:
+    static uint64_t mix(uint64_t value) {
+        //    :    ,   
+        value *= 0x9E3779B97F4A7C15ULL;
+        return value ^ (value >> 29);
+    }
+
+    //     ,      
+    uint64_t checkOf(const char* data, uint64_t size) const {
+        return mix(reinterpret_cast<uintptr_t>(data) ^ secret ^ (size << 32 | size >> 32));
+    }
+
+    static Header* headerOf(char* data) {
+        return reinterpret_cast<Header*>(data - kHeader);
+    }
+
+    //    ;     
+    static bool isPoisoned(const char* data, size_t length) {
+        const uint64_t pattern = 0x0101010101010101ULL * kPoison;
+        uint64_t difference = 0;
+        size_t i = 0;
+        for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+            uint64_t word;
+            std::memcpy(&word, data + i, sizeof(word));
+            difference |= word ^ pattern;
+        }
+        for (; i < length; ++i)
+            difference |= static_cast<unsigned char>(data[i]) ^ kPoison;
+        return difference == 0;
+    }
+
+    void report(Problem problem, const void* address, size_t size) {
+        ++violationCount;
+        options.onViolation(Violation{ problem, address, size });
+    }
+
+    //     ;       (   )
+    void release(void* address, const size_t* expectedSize) {
+        if (!address)
+            return;
+        char* data = static_cast<char*>(address);
+        if (!guardedBlocks.empty()) {
+            auto found = guardedBlocks.find(data);
+            if (found != guardedBlocks.end()) {
+                releaseGuarded(data, found->second, expectedSize);
+                return;
+            }
+        }
+
+        Header* header = headerOf(data);
+        size_t size = static_cast<size_t>(header->size);
+        uint64_t check = checkOf(data, size);
+        if ((header->state != kLive && header->state != kFreed) || header->check != check) {
+            report(Problem::BadHeader, data, 0);
+            return;
+        }
+        if (header->state == kFreed) {
+            report(Problem::DoubleFree, data, size);
+            return;
+        }
+        if (expectedSize && *expectedSize != size) {
+            report(Problem::SizeMismatch, data, size);
+            return;
+        }
+        uint64_t footer;
+        std::memcpy(&footer, data + size, sizeof(footer));
+        if (footer != check) {
+            //           -   
+            report(Problem::Overflow, data, size);
+            return;
+        }
+
+        if (quarantine.empty()) {
+            //      
+            manager.deallocate(data - kHeader, kHeader + size + kFooter);
+            return;
+        }
+        header->state = kFreed;
+        std::memset(data, kPoison, std::min(options.poisonBytes, size));
+        enqueue(Quarantined{ data, size, check, false });
+    }
+
+    void enqueue(const Quarantined& block) {
+        if (quarantineCount == quarantine.size())
+            evict();
+        quarantine[(quarantineHead + quarantineCount++) % quarantine.size()] = block;
+        quarantinedBytes += block.size;
+        while (quarantineCount && quarantinedBytes > options.quarantineBytes)
+            evict();
+    }
+
+    //    :       , 
+    //     ,    ,     
+    void evict() {
+        Quarantined block = quarantine[quarantineHead];
+        quarantineHead = (quarantineHead + 1) % quarantine.size();
+        --quarantineCount;
+        quarantinedBytes -= block.size;
+        if (block.guarded) {
+            guardedBlocks.erase(block.data); // Region     
+            return;
+        }
+        Header* header = headerOf(block.data);
+        bool intact = header->state == kFreed && header->size == block.size && header->check == block.check
+            && isPoisoned(block.data, std::min(options.poisonBytes, block.size));
+        if (!intact) {
+            report(Problem::UseAfterFree, block.data, block.size);
+            return;
+        }
+        manager.deallocate(block.data - kHeader, kHeader + block.size + kFooter);
+    }
+
+    //       ,   -   :
+    //             
+    void* allocateGuarded(size_t size) {
+        size_t page = VirtualMemory::systemPageSize();
+        size_t padded = VirtualMemory::roundUp(size, kAlignment);
+        size_t span = VirtualMemory::roundUp(padded, page);
+        std::unique_ptr<VirtualMemory::Region> region;
+        try {
+            region = std::make_unique<VirtualMemory::Region>(span + page);
+        }
+        catch (const std::bad_alloc&) {
+            return nullptr;
+        }
+        if (!region->commit(span))
+            return nullptr;
+        char* data = region->begin() + span - padded;
+        std::memset(data + size, kSlack, padded - size);
+        guardedBlocks.emplace(data, GuardedBlock{ std::move(region), size, false });
+        return data;
+    }
+
+    //    :         -  
+    void releaseGuarded(char* data, GuardedBlock& block, const size_t* expectedSize) {
+        if (block.freed) {
+            report(Problem::DoubleFree, data, block.size);
+            return;
+        }
+        if (expectedSize && *expectedSize != block.size) {
+            report(Problem::SizeMismatch, data, block.size);
+            return;
+        }
+        size_t padded = VirtualMemory::roundUp(block.size, kAlignment);
+        for (size_t i = block.size; i < padded; ++i) {
+            if (static_cast<unsigned char>(data[i]) != kSlack) {
+                report(Problem::Overflow, data, block.size);
+                return;
+            }
+        }
+        if (quarantine.empty()) {
+            guardedBlocks.erase(data);
+            return;
+        }
+        block.freed = true;
+        block.region->revoke();
+        enqueue(Quarantined{ data, block.size, 0, true });
+    }
+};
+
+} // namespace Checked
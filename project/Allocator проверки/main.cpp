@@ -0,0 +1,221 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include "CheckedHeap.h"
+#include "Workload.h"
+#include "BuddyManager.h"
+#include "BoundaryTagManager.h"
+#include "SortedListManager.h"
+#include "RedBlackManager.h"
+
+#ifndef _WIN32
+#include <csignal>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using Checked::CheckedHeap;
+using Checked::Problem;
+using Clock = std::chrono::steady_clock;
+
+static const size_t kPoolSize = 256 * 1024 * 1024;
+
+//  :  ,  
+static std::vector<Checked::Violation> recorded;
+
+static void record(const Checked::Violation& violation) {
+    recorded.push_back(violation);
+}
+
+//  ,    
+static bool expect(Problem problem, const void* address) {
+    bool found = recorded.size() == 1 && recorded[0].problem == problem && recorded[0].address == address;
+    recorded.clear();
+    return found;
+}
+
+//     ;     .    
+//         ,     .
+template <class Manager>
+bool checkDetection(const char* label) {
+    Checked::Options options;
+    options.onViolation = record;
+    options.guardThreshold = 64 * 1024;
+    CheckedHeap<Manager> heap(options, kPoolSize);
+    size_t initialFree = heap.underlying().freeBytes();
+    size_t leaked = 0; //    ,    
+    int passed = 0;
+
+    //      
+    size_t before = heap.underlying().freeBytes();
+    char* block = static_cast<char*>(heap.allocate(100));
+    leaked += before - heap.underlying().freeBytes();
+    block[100] = 'x';
+    heap.deallocate(block);
+    passed += expect(Problem::Overflow, block);
+
+    //   -    
+    block = static_cast<char*>(heap.allocate(200));
+    heap.deallocate(block);
+    heap.deallocate(block);
+    passed += expect(Problem::DoubleFree, block);
+
+    //         
+    static char foreign[256];
+    block = static_cast<char*>(heap.allocate(300));
+    heap.deallocate(block + 48);
+    bool interior = expect(Problem::BadHeader, block + 48);
+    heap.deallocate(foreign + 128);
+    passed += interior && expect(Problem::BadHeader, foreign + 128);
+
+    //     ,   
+    heap.deallocate(block, 301);
+    passed += expect(Problem::SizeMismatch, block);
+    heap.deallocate(block, 300);
+
+    //         
+    before = heap.underlying().freeBytes();
+    block = static_cast<char*>(heap.allocate(400));
+    leaked += before - heap.underlying().freeBytes();
+    heap.deallocate(block);
+    block[10] = 'x';
+    heap.drain();
+    passed += expect(Problem::UseAfterFree, block);
+
+    //     :    ;   ,
+    //          
+    block = static_cast<char*>(heap.allocate(100 * 1024 + 3));
+    block[100 * 1024 + 3] = 'x';
+    heap.deallocate(block);
+    bool slack = expect(Problem::Overflow, block);
+    heap.deallocate(block);
+    passed += slack && expect(Problem::Overflow, block);
+
+    //     -     
+    block = static_cast<char*>(heap.allocate(100 * 1024));
+    heap.deallocate(block);
+    heap.deallocate(block);
+    passed += expect(Problem::DoubleFree, block);
+
+    heap.drain();
+    bool intact = recorded.empty() && heap.underlying().freeBytes() == initialFree - leaked;
+    std::cout << std::left << std::setw(16) << label << std::right << std::setw(8) << passed << "/7"
+              << std::setw(10) << heap.violations() << std::setw(8) << (intact ? "ok" : "FAIL") << std::endl;
+    return passed == 7 && intact;
+}
+
+#ifndef _WIN32
+//               
+//  ,     .  -   .
+static bool expectFault(bool afterFree) {
+    pid_t child = fork();
+    if (child == 0) {
+        signal(SIGSEGV, SIG_DFL);
+        Checked::Options options;
+        options.guardThreshold = 64 * 1024;
+        CheckedHeap<BoundaryTags::MemoryManager<>> heap(options, size_t(1) << 20);
+        volatile char* block = static_cast<char*>(heap.allocate(100 * 1024));
+        if (afterFree) {
+            heap.deallocate(const_cast<char*>(block));
+            block[0] = 'x';
+        }
+        else {
+            for (size_t i = 100 * 1024; i < 200 * 1024; ++i)
+                block[i] = 'x';
+        }
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    return WIFSIGNALED(status) && WTERMSIG(status) == SIGSEGV;
+}
+#endif
+
+//  ,    (    -  )
+template <class Heap, class... Args>
+double replay(const Trace& trace, Args&&... args) {
+    double best = 0;
+    std::vector<char*> slots(trace.blocks, nullptr);
+    for (int run = 0; run < 3; ++run) {
+        Heap heap(args...);
+        auto start = Clock::now();
+        for (const Operation& op : trace.operations) {
+            char*& slot = slots[op.id];
+            if (op.allocate) {
+                slot = static_cast<char*>(heap.allocate(op.size));
+                if (slot)
+                    slot[0] = 1; //     
+            }
+            else if (slot) {
+                heap.deallocate(slot, op.size);
+                slot = nullptr;
+            }
+        }
+        double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / trace.operations.size();
+        best = run == 0 ? ns : std::min(best, ns);
+        for (size_t id = 0; id < slots.size(); ++id) {
+            if (slots[id])
+                heap.deallocate(slots[id]);
+            slots[id] = nullptr;
+        }
+    }
+    return best;
+}
+
+//    :    ,  ,   
+template <class Manager>
+void measureOverhead(const char* label, const Trace& trace) {
+    Checked::Options canaries;
+    canaries.quarantineBlocks = 0;
+    Checked::Options quarantine;
+    Checked::Options guarded;
+    guarded.guardThreshold = 16 * 1024;
+
+    double raw = replay<Manager>(trace, kPoolSize);
+    double costs[3] = {
+        replay<CheckedHeap<Manager>>(trace, canaries, kPoolSize),
+        replay<CheckedHeap<Manager>>(trace, quarantine, kPoolSize),
+        replay<CheckedHeap<Manager>>(trace, guarded, kPoolSize)
+    };
+    std::cout << std::left << std::setw(18) << trace.name << std::setw(15) << label << std::right
+              << std::fixed << std::setprecision(1) << std::setw(8) << raw;
+    for (double cost : costs)
+        std::cout << std::setw(9) << cost << std::setw(6) << static_cast<int>((cost / raw - 1) * 100 + 0.5) << "%";
+    std::cout << std::endl;
+}
+
+int main() {
+    std::cout << std::left << std::setw(16) << "manager" << std::right << std::setw(10) << "detected"
+              << std::setw(10) << "reports" << std::setw(8) << "pool" << std::endl;
+    bool ok = checkDetection<BoundaryTags::MemoryManager<>>("boundary tags");
+    ok = checkDetection<Buddy::MemoryManager<>>("buddy") && ok;
+    ok = checkDetection<SortedList::MemoryManager<>>("sorted list") && ok;
+    ok = checkDetection<RedBlack::MemoryManager<>>("red-black") && ok;
+
+#ifndef _WIN32
+    bool overflowFault = expectFault(false);
+    bool freedFault = expectFault(true);
+    std::cout << "guard page: overflow " << (overflowFault ? "SIGSEGV" : "missed")
+              << ", write after free " << (freedFault ? "SIGSEGV" : "missed") << std::endl;
+    ok = ok && overflowFault && freedFault;
+#endif
+
+    //     ,         .
+    // guard -   16KB    (      ).
+    std::cout << std::endl << std::left << std::setw(18) << "workload" << std::setw(15) << "manager" << std::right
+              << std::setw(8) << "raw ns" << std::setw(16) << "canaries" << std::setw(16) << "+quarantine"
+              << std::setw(16) << "+guard 16K" << std::endl;
+    for (SizeDistribution distribution : { SizeDistribution::Uniform, SizeDistribution::PowerLaw }) {
+        for (FreeOrder order : { FreeOrder::Lifo, FreeOrder::Random }) {
+            Trace trace = generateTrace(distribution, order, 10000, 200000);
+            measureOverhead<BoundaryTags::MemoryManager<>>("boundary tags", trace);
+            measureOverhead<Buddy::MemoryManager<>>("buddy", trace);
+        }
+    }
+    std::cout << (ok ? "ok" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,270 @@
+//SortedList::FreeIndex :     :       ,  -  .       ,      .
+//reserve(size_t slots) :    slots  -    ;     ,       .
+//insert(void* block, size_t size) :     ,   .      .
+//update(size_t slot, size_t size) :      slot.
+//erase(size_t slot) :  :      ,   ,    .
+//bestFit(size_t needed, Probe& probe) :      needed:    ,    .
+//worstFit(size_t needed, Probe& probe) :   ,     needed.
+// : AVX2 (8   )  __AVX2__,  SSE2 (4 )  x86/x64,   .
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <new>
+#include "AllocatorStats.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SORTED_LIST_INDEX_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SORTED_LIST_INDEX_SSE2
+#endif
+
+namespace SortedList {
+
+class FreeIndex {
+public:
+    static const size_t npos = static_cast<size_t>(-1);
+
+private:
+    //      16  (   16)  32- :
+    //   AVX2  8 .   64GB   0xFFFFFFFF,
+    //            .
+    static const size_t kUnitShift = 4;
+    static const size_t kLanes = 8;         //    8 ,   
+    static const size_t kArrayAlignment = 32;
+
+    uint32_t* sizes;   //    
+    void** blocks;     //      
+    size_t count;      //   
+    size_t capacity;   //    ( kLanes)
+
+    static void release(void* array) { ::operator delete(array, std::align_val_t(kArrayAlignment)); }
+
+public:
+    FreeIndex() : sizes(nullptr), blocks(nullptr), count(0), capacity(0) {}
+
+    ~FreeIndex() {
+        release(sizes);
+        release(blocks);
+    }
+
+    FreeIndex(const FreeIndex&) = delete;
+    FreeIndex& operator=(const FreeIndex&) = delete;
+
+    size_t size() const { return count; }
+    void* block(size_t slot) const { return blocks[slot]; }
+
+    //    :       .
+    //         kLanes ,   insert.
+    void reserve(size_t slots) {
+        size_t newCapacity = (slots + kLanes - 1) / kLanes * kLanes;
+        if (newCapacity <= capacity)
+            return;
+        uint32_t* newSizes = static_cast<uint32_t*>(::operator new(newCapacity * sizeof(uint32_t), std::align_val_t(kArrayAlignment)));
+        void** newBlocks;
+        try {
+            newBlocks = static_cast<void**>(::operator new(newCapacity * sizeof(void*), std::align_val_t(kArrayAlignment)));
+        }
+        catch (...) {
+            //   ,      
+            release(newSizes);
+            throw;
+        }
+        size_t used = (count + kLanes - 1) / kLanes * kLanes;
+        if (used) {
+            std::memcpy(newSizes, sizes, used * sizeof(uint32_t));
+            std::memcpy(newBlocks, blocks, count * sizeof(void*));
+        }
+        release(sizes);
+        release(blocks);
+        sizes = newSizes;
+        blocks = newBlocks;
+        capacity = newCapacity;
+    }
+
+    //     reserve;  -  
+    size_t insert(void* block, size_t size) {
+        if (count % kLanes == 0)
+            std::memset(sizes + count, 0, kLanes * sizeof(uint32_t));
+        sizes[count] = units(size);
+        blocks[count] = block;
+        return count++;
+    }
+
+    void update(size_t slot, size_t size) { sizes[slot] = units(size); }
+
+    //      ;    (nullptr, 
+    //  ) -      
+    void* erase(size_t slot) {
+        --count;
+        void* moved = nullptr;
+        if (slot != count) {
+            sizes[slot] = sizes[count];
+            blocks[slot] = moved = blocks[count];
+        }
+        sizes[count] = 0; //         
+        return moved;
+    }
+
+    //     needed.   -    ,
+    //        0xFFFFFFFF;  -   .
+    size_t bestFit(size_t needed, Stats::Probe& probe) const {
+        uint32_t need = units(needed);
+        uint32_t best = 0xFFFFFFFFu;
+#if defined(SORTED_LIST_INDEX_AVX2)
+        size_t exact = npos;
+        const __m256i threshold = _mm256_set1_epi32(static_cast<int>(need));
+        __m256i minimum = _mm256_set1_epi32(-1);
+        for (size_t i = 0; i < count; i += 8) {
+            probe.step();
+            __m256i v = _mm256_load_si256(reinterpret_cast<const __m256i*>(sizes + i));
+            __m256i fits = _mm256_cmpeq_epi32(_mm256_max_epu32(v, threshold), v);
+            int hit = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(v, threshold)));
+            if (hit) {
+                exact = i + lowestBit(hit);
+                break;
+            }
+            minimum = _mm256_min_epu32(minimum, _mm256_or_si256(v, _mm256_andnot_si256(fits, _mm256_set1_epi32(-1))));
+        }
+        if (exact != npos)
+            return exact;
+        __m128i half = _mm_min_epu32(_mm256_castsi256_si128(minimum), _mm256_extracti128_si256(minimum, 1));
+        half = _mm_min_epu32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+        half = _mm_min_epu32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+        best = static_cast<uint32_t>(_mm_cvtsi128_si32(half));
+#elif defined(SORTED_LIST_INDEX_SSE2)
+        //  SSE2   :      0x80000000
+        size_t exact = npos;
+        const __m128i bias = _mm_set1_epi32(static_cast<int>(0x80000000u));
+        const __m128i threshold = _mm_set1_epi32(static_cast<int>(need));
+        const __m128i biasedThreshold = _mm_xor_si128(threshold, bias);
+        __m128i minimum = _mm_set1_epi32(0x7FFFFFFF); // 0xFFFFFFFF  
+        for (size_t i = 0; i < count; i += 4) {
+            probe.step();
+            __m128i v = _mm_load_si128(reinterpret_cast<const __m128i*>(sizes + i));
+            int hit = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(v, threshold)));
+            if (hit) {
+                exact = i + lowestBit(hit);
+                break;
+            }
+            __m128i biased = _mm_xor_si128(v, bias);
+            __m128i small = _mm_cmplt_epi32(biased, biasedThreshold);
+            biased = _mm_or_si128(_mm_andnot_si128(small, biased), _mm_and_si128(small, _mm_set1_epi32(0x7FFFFFFF)));
+            __m128i less = _mm_cmplt_epi32(biased, minimum);
+            minimum = _mm_or_si128(_mm_and_si128(less, biased), _mm_andnot_si128(less, minimum));
+        }
+        if (exact != npos)
+            return exact;
+        alignas(16) int32_t lanes[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), minimum);
+        for (int32_t lane : lanes)
+            best = std::min(best, static_cast<uint32_t>(lane) ^ 0x80000000u);
+#else
+        for (size_t i = 0; i < count; ++i) {
+            probe.step();
+            if (sizes[i] >= need && sizes[i] < best) {
+                best = sizes[i];
+                if (best == need)
+                    return i;
+            }
+        }
+#endif
+        if (best == 0xFFFFFFFFu && !anyAtLeast(need))
+            return npos;
+        return position(best);
+    }
+
+    //  :    ,      
+    size_t worstFit(size_t needed, Stats::Probe& probe) const {
+        uint32_t need = units(needed);
+        uint32_t worst = 0;
+#if defined(SORTED_LIST_INDEX_AVX2)
+        __m256i maximum = _mm256_setzero_si256();
+        for (size_t i = 0; i < count; i += 8) {
+            probe.step();
+            maximum = _mm256_max_epu32(maximum, _mm256_load_si256(reinterpret_cast<const __m256i*>(sizes + i)));
+        }
+        __m128i half = _mm_max_epu32(_mm256_castsi256_si128(maximum), _mm256_extracti128_si256(maximum, 1));
+        half = _mm_max_epu32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+        half = _mm_max_epu32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+        worst = static_cast<uint32_t>(_mm_cvtsi128_si32(half));
+#elif defined(SORTED_LIST_INDEX_SSE2)
+        const __m128i bias = _mm_set1_epi32(static_cast<int>(0x80000000u));
+        __m128i maximum = bias; // 0  
+        for (size_t i = 0; i < count; i += 4) {
+            probe.step();
+            __m128i biased = _mm_xor_si128(_mm_load_si128(reinterpret_cast<const __m128i*>(sizes + i)), bias);
+            __m128i greater = _mm_cmpgt_epi32(biased, maximum);
+            maximum = _mm_or_si128(_mm_and_si128(greater, biased), _mm_andnot_si128(greater, maximum));
+        }
+        alignas(16) int32_t lanes[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), maximum);
+        for (int32_t lane : lanes)
+            worst = std::max(worst, static_cast<uint32_t>(lane) ^ 0x80000000u);
+#else
+        for (size_t i = 0; i < count; ++i) {
+            probe.step();
+            worst = sizes[i] > worst ? sizes[i] : worst;
+        }
+#endif
+        if (count == 0 || worst < need)
+            return npos;
+        return position(worst);
+    }
+
+private:
+    static uint32_t units(size_t size) {
+        size_t value = size >> kUnitShift;
+        return value > 0xFFFFFFFFu ? 0xFFFFFFFFu : static_cast<uint32_t>(value);
+    }
+
+    static size_t lowestBit(int mask) {
+        size_t bit = 0;
+        while (!(mask & 1)) {
+            mask >>= 1;
+            ++bit;
+        }
+        return bit;
+    }
+
+    //  0xFFFFFFFF     ,      64GB
+    bool anyAtLeast(uint32_t need) const {
+        for (size_t i = 0; i < count; ++i) {
+            if (sizes[i] >= need)
+                return true;
+        }
+        return false;
+    }
+
+    //      value ( ,   )
+    size_t position(uint32_t value) const {
+#if defined(SORTED_LIST_INDEX_AVX2)
+        const __m256i target = _mm256_set1_epi32(static_cast<int>(value));
+        for (size_t i = 0; i < count; i += 8) {
+            __m256i v = _mm256_load_si256(reinterpret_cast<const __m256i*>(sizes + i));
+            int hit = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(v, target)));
+            if (hit)
+                return i + lowestBit(hit);
+        }
+#elif defined(SORTED_LIST_INDEX_SSE2)
+        const __m128i target = _mm_set1_epi32(static_cast<int>(value));
+        for (size_t i = 0; i < count; i += 4) {
+            __m128i v = _mm_load_si128(reinterpret_cast<const __m128i*>(sizes + i));
+            int hit = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(v, target)));
+            if (hit)
+                return i + lowestBit(hit);
+        }
+#else
+        for (size_t i = 0; i < count; ++i) {
+            if (sizes[i] == value)
+                return i;
+        }
+#endif
+        return npos;
+    }
+};
+
+} // namespace SortedList
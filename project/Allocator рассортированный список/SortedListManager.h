@@ -0,0 +1,464 @@
+//MemoryBlock :      :     .
+//MemoryManager :     ,       ,   ;       .
+//FirstFit, NextFit, BestFit, WorstFit :   -   MemoryManager,       .
+//IndexedBestFit, IndexedWorstFit :       ,      FreeIndex (SIMD)   .
+//MemoryManager(size_t size) :  ,     new[]        .
+//allocate(size_t size) :      ,       .    .
+//deallocate(void* address) :     ,     .           .
+//deallocate(void* address, size_t size) :    ,    (  ).
+//allocateBatch(size_t size, size_t count, void** out) :              .
+//deallocateBatch(void** ptrs, size_t count, size_t size) :  :      ,       .
+//slideDown(void* address) / nextAllocated(void* address) :               ( ).
+//forEachFreeBlock(Visit visit) :       Stats::snapshot,      ALLOCATOR_STATS.
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <functional>
+#include "AllocatorStats.h"
+#include "FreeIndex.h"
+
+namespace SortedList {
+
+//        (     )
+struct MemoryBlock {
+    size_t size;   //      
+};
+
+//  :     .  -  
+// MemoryManager,      ,    
+//      .  ,      
+//  (reserve,      ),     
+// (remember),   (resized)     (forget).
+struct PlacementPolicy {
+    void reserve(size_t) {}
+    template <class Node>
+    void remember(Node*) {}
+    template <class Node>
+    void resized(Node*) {}
+    template <class Node>
+    void forget(Node*) {}
+};
+
+//   
+struct FirstFit : PlacementPolicy {
+    template <class Node>
+    Node* find(Node* head, size_t needed, Stats::Probe& probe) {
+        for (Node* node = head; node; node = node->next) {
+            probe.step();
+            if (node->size >= needed)
+                return node;
+        }
+        return nullptr;
+    }
+};
+
+//   :      
+struct NextFit : PlacementPolicy {
+    void* rover = nullptr; // ,     
+
+    template <class Node>
+    Node* find(Node* head, size_t needed, Stats::Probe& probe) {
+        Node* start = rover ? static_cast<Node*>(rover) : head;
+        for (Node* node = start; node; node = node->next) {
+            probe.step();
+            if (node->size >= needed)
+                return static_cast<Node*>(rover = node);
+        }
+        for (Node* node = head; node != start; node = node->next) {
+            probe.step();
+            if (node->size >= needed)
+                return static_cast<Node*>(rover = node);
+        }
+        return nullptr;
+    }
+
+    //     -    
+    template <class Node>
+    void forget(Node* node) {
+        if (rover == node)
+            rover = node->next;
+    }
+};
+
+//    (  )
+struct BestFit : PlacementPolicy {
+    template <class Node>
+    Node* find(Node* head, size_t needed, Stats::Probe& probe) {
+        Node* best = nullptr;
+        for (Node* node = head; node; node = node->next) {
+            probe.step();
+            if (node->size >= needed && (!best || node->size < best->size)) {
+                best = node;
+                if (node->size == needed)
+                    break; //   
+            }
+        }
+        return best;
+    }
+};
+
+//    ()
+struct WorstFit : PlacementPolicy {
+    template <class Node>
+    Node* find(Node* head, size_t needed, Stats::Probe& probe) {
+        Node* worst = nullptr;
+        for (Node* node = head; node; node = node->next) {
+            probe.step();
+            if (node->size >= needed && (!worst || node->size > worst->size))
+                worst = node;
+        }
+        return worst;
+    }
+};
+
+//     :       
+// ,   .         .
+struct IndexedPolicy : PlacementPolicy {
+    FreeIndex index;
+
+    void reserve(size_t nodes) { index.reserve(nodes); }
+
+    template <class Node>
+    void remember(Node* node) { node->slot = index.insert(node, node->size); }
+
+    template <class Node>
+    void resized(Node* node) { index.update(node->slot, node->size); }
+
+    template <class Node>
+    void forget(Node* node) {
+        if (Node* moved = static_cast<Node*>(index.erase(node->slot)))
+            moved->slot = node->slot;
+    }
+};
+
+//       
+struct IndexedBestFit : IndexedPolicy {
+    template <class Node>
+    Node* find(Node* head, size_t needed, Stats::Probe& probe) {
+        size_t slot = index.bestFit(needed, probe);
+        if (slot == FreeIndex::npos)
+            return nullptr;
+        Node* node = static_cast<Node*>(index.block(slot));
+        //      (  64GB),   
+        return node->size >= needed ? node : BestFit().find(head, needed, probe);
+    }
+};
+
+//       
+struct IndexedWorstFit : IndexedPolicy {
+    template <class Node>
+    Node* find(Node* head, size_t needed, Stats::Probe& probe) {
+        size_t slot = index.worstFit(needed, probe);
+        if (slot == FreeIndex::npos)
+            return nullptr;
+        Node* node = static_cast<Node*>(index.block(slot));
+        return node->size >= needed ? node : WorstFit().find(head, needed, probe);
+    }
+};
+
+//     
+template <class Policy = FirstFit>
+class MemoryManager {
+public:
+    static const size_t kAlignment = 16; //     
+
+private:
+    //    ,     
+    struct Node {
+        size_t size; //    (   ,   MemoryBlock::size)
+        Node* next;
+        Node* prev;
+        size_t slot; //     (  IndexedBestFit/IndexedWorstFit)
+    };
+
+    static const size_t kHeaderSize = (sizeof(MemoryBlock) + kAlignment - 1) & ~(kAlignment - 1);
+    static const size_t kMinBlockSize = (sizeof(Node) + kAlignment - 1) & ~(kAlignment - 1);
+
+    void* memoryPool;  //     
+    size_t memorySize; //   
+    Node* head;        //   (    )
+    Policy policy;     //  
+    ALLOCATOR_STAT(Stats::Counters stats;) //  
+
+public:
+    MemoryManager(size_t size) : memorySize(size), head(nullptr) {
+        //     ,        
+        // ,     poolSize / (2 * kMinBlockSize) + 1.    -  
+        // ,      ,        .
+        policy.reserve(size / (2 * kMinBlockSize) + 2);
+
+        //    
+        memoryPool = new char[size + kAlignment];
+
+        //    -   
+        char* begin = alignUp(reinterpret_cast<char*>(memoryPool));
+        size_t poolSize = size & ~(kAlignment - 1);
+        if (poolSize >= kMinBlockSize) {
+            head = reinterpret_cast<Node*>(begin);
+            head->size = poolSize;
+            head->next = nullptr;
+            head->prev = nullptr;
+            policy.remember(head);
+        }
+    }
+
+    ~MemoryManager() {
+        //     ,     
+        delete[] reinterpret_cast<char*>(memoryPool);
+    }
+
+    MemoryManager(const MemoryManager&) = delete;
+    MemoryManager& operator=(const MemoryManager&) = delete;
+
+    //       (   )
+    void* allocate(size_t size) {
+        if (size == 0 || size > memorySize)
+            return nullptr;
+        size_t needed = blockSizeFor(size);
+
+        Stats::Probe probe;
+        Node* current = policy.find(head, needed, probe);
+        if (!current) {
+            //     ,  nullptr
+            ALLOCATOR_STAT(stats.onAllocate(size, 0, probe));
+            return nullptr;
+        }
+
+        MemoryBlock* block;
+        if (current->size - needed >= kMinBlockSize) {
+            //    -       
+            current->size -= needed;
+            policy.resized(current);
+            block = reinterpret_cast<MemoryBlock*>(reinterpret_cast<char*>(current) + current->size);
+            block->size = needed;
+            ALLOCATOR_STAT(stats.onSplit());
+        }
+        else {
+            //   ,    
+            unlink(current);
+            block = reinterpret_cast<MemoryBlock*>(current);
+        }
+        ALLOCATOR_STAT(stats.onAllocate(size, block->size, probe));
+        return reinterpret_cast<char*>(block) + kHeaderSize;
+    }
+
+    //         (    )
+    void deallocate(void* address) {
+        if (!address)
+            return;
+        Node* newNode = reinterpret_cast<Node*>(reinterpret_cast<char*>(address) - kHeaderSize);
+        ALLOCATOR_STAT(stats.onDeallocate(newNode->size));
+
+        //        
+        Node* prev = nullptr;
+        Node* current = head;
+        while (current && current < newNode) {
+            prev = current;
+            current = current->next;
+        }
+        insertFree(prev, current, newNode);
+    }
+
+    void deallocate(void* address, size_t size) {
+        (void)size;
+        deallocate(address);
+    }
+
+    //  count   size  out.      
+    //   ,    ,      -,
+    //     .     ( count -  ).
+    size_t allocateBatch(size_t size, size_t count, void** out) {
+        if (size == 0 || size > memorySize)
+            return 0;
+        size_t needed = blockSizeFor(size);
+
+        size_t done = 0;
+        while (done < count) {
+            Stats::Probe probe;
+            Node* current = policy.find(head, needed, probe);
+            if (!current) {
+                ALLOCATOR_STAT(stats.onAllocate(size, 0, probe));
+                break;
+            }
+
+            //     ;       
+            size_t take = std::min(count - done, current->size / needed);
+            size_t rest = current->size - take * needed;
+            char* chunk;
+            if (rest >= kMinBlockSize) {
+                current->size = rest;
+                policy.resized(current);
+                chunk = reinterpret_cast<char*>(current) + rest;
+                ALLOCATOR_STAT(stats.onSplit());
+            }
+            else {
+                unlink(current);
+                chunk = reinterpret_cast<char*>(current);
+            }
+            for (size_t i = 0; i < take; ++i) {
+                size_t chunkSize = i == 0 && rest < kMinBlockSize ? needed + rest : needed;
+                reinterpret_cast<MemoryBlock*>(chunk)->size = chunkSize;
+                out[done++] = chunk + kHeaderSize;
+                chunk += chunkSize;
+                ALLOCATOR_STAT(stats.onAllocate(size, chunkSize, i == 0 ? probe : Stats::Probe()));
+            }
+        }
+        return done;
+    }
+
+    //  count   size.     ( ptrs
+    // ),       ,  
+    //          .
+    void deallocateBatch(void** ptrs, size_t count, size_t size) {
+        (void)size;
+        std::sort(ptrs, ptrs + count, [](void* a, void* b) { return std::less<void*>()(a, b); });
+
+        Node* prev = nullptr;
+        Node* current = head;
+        for (size_t i = 0; i < count; ) {
+            if (!ptrs[i]) {
+                ++i;
+                continue;
+            }
+            Node* newNode = reinterpret_cast<Node*>(reinterpret_cast<char*>(ptrs[i++]) - kHeaderSize);
+            ALLOCATOR_STAT(stats.onDeallocate(newNode->size));
+            while (i < count && reinterpret_cast<char*>(ptrs[i]) - kHeaderSize == reinterpret_cast<char*>(newNode) + newNode->size) {
+                size_t nextSize = reinterpret_cast<MemoryBlock*>(reinterpret_cast<char*>(ptrs[i++]) - kHeaderSize)->size;
+                newNode->size += nextSize;
+                ALLOCATOR_STAT(stats.onDeallocate(nextSize); stats.onMerge());
+            }
+
+            while (current && current < newNode) {
+                prev = current;
+                current = current->next;
+            }
+            prev = insertFree(prev, current, newNode);
+            current = prev->next;
+        }
+    }
+
+    //       ,     :  
+    //    memmove,         
+    //   .     ,   .
+    //    ,   .
+    void* slideDown(void* address) {
+        char* block = reinterpret_cast<char*>(address) - kHeaderSize;
+        Node* prev = nullptr;
+        Node* current = head;
+        while (current && reinterpret_cast<char*>(current) < block) {
+            prev = current;
+            current = current->next;
+        }
+        if (!prev || reinterpret_cast<char*>(prev) + prev->size != block)
+            return address;
+
+        size_t freeSize = prev->size;
+        size_t blockSize = reinterpret_cast<MemoryBlock*>(block)->size;
+        Node* before = prev->prev;
+        unlink(prev);
+        std::memmove(prev, block, blockSize);
+
+        Node* hole = reinterpret_cast<Node*>(reinterpret_cast<char*>(prev) + blockSize);
+        hole->size = freeSize;
+        insertFree(before, current, hole);
+        return reinterpret_cast<char*>(prev) + kHeaderSize;
+    }
+
+    //     address      (nullptr  address -
+    //   ), nullptr -    .   ,  :
+    //    ,         .
+    void* nextAllocated(void* address) const {
+        char* begin = alignUp(reinterpret_cast<char*>(memoryPool));
+        size_t poolSize = memorySize & ~(kAlignment - 1);
+        char* end = poolSize >= kMinBlockSize ? begin + poolSize : begin;
+        char* p = address ? reinterpret_cast<char*>(address) - kHeaderSize : begin;
+        if (address)
+            p += reinterpret_cast<MemoryBlock*>(p)->size;
+        const Node* node = head;
+        while (node && reinterpret_cast<const char*>(node) < p)
+            node = node->next;
+        if (node && reinterpret_cast<const char*>(node) == p)
+            p += node->size;
+        return p < end ? p + kHeaderSize : nullptr;
+    }
+
+    //     (  )
+    size_t freeBytes() const {
+        size_t total = 0;
+        for (const Node* node = head; node; node = node->next)
+            total += node->size;
+        return total;
+    }
+
+    //    
+    size_t largestFreeBlock() const {
+        size_t largest = 0;
+        for (const Node* node = head; node; node = node->next)
+            largest = node->size > largest ? node->size : largest;
+        return largest;
+    }
+
+    //      , visit(size)  
+    template <class Visit>
+    void forEachFreeBlock(Visit visit) const {
+        for (const Node* node = head; node; node = node->next)
+            visit(node->size);
+    }
+
+#ifdef ALLOCATOR_STATS
+    const Stats::Counters& counters() const { return stats; }
+#endif
+
+private:
+    static char* alignUp(char* p) {
+        uintptr_t value = reinterpret_cast<uintptr_t>(p);
+        return reinterpret_cast<char*>((value + kAlignment - 1) & ~static_cast<uintptr_t>(kAlignment - 1));
+    }
+
+    //     :   ,    
+    static size_t blockSizeFor(size_t size) {
+        size_t total = (size + kHeaderSize + kAlignment - 1) & ~(kAlignment - 1);
+        return total < kMinBlockSize ? kMinBlockSize : total;
+    }
+
+    //        prev  current    .
+    //  ,    .
+    Node* insertFree(Node* prev, Node* current, Node* newNode) {
+        //    :   ,    
+        if (prev && reinterpret_cast<char*>(prev) + prev->size == reinterpret_cast<char*>(newNode)) {
+            prev->size += newNode->size;
+            newNode = prev;
+            policy.resized(newNode);
+            ALLOCATOR_STAT(stats.onMerge());
+        }
+        else {
+            newNode->prev = prev;
+            newNode->next = current;
+            if (prev) prev->next = newNode;
+            else head = newNode;
+            if (current) current->prev = newNode;
+            policy.remember(newNode);
+        }
+
+        //    
+        if (current && reinterpret_cast<char*>(newNode) + newNode->size == reinterpret_cast<char*>(current)) {
+            newNode->size += current->size;
+            unlink(current);
+            policy.resized(newNode);
+            ALLOCATOR_STAT(stats.onMerge());
+        }
+        return newNode;
+    }
+
+    //    
+    void unlink(Node* node) {
+        policy.forget(node);
+        if (node->prev) node->prev->next = node->next;
+        else head = node->next;
+        if (node->next) node->next->prev = node->prev;
+    }
+};
+
+} // namespace SortedList
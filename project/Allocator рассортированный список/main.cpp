@@ -1,167 +1,154 @@
+#define ALLOCATOR_STATS //    (    )
 #include <iostream>
-
-//       
-struct MemoryBlock {
-    void* address; //    
-    size_t size;   //   
-
-    MemoryBlock(void* addr, size_t sz) : address(addr), size(sz) {}
+#include <iomanip>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <random>
+#include <deque>
+#include "SortedListManager.h"
+
+using namespace SortedList;
+
+//    :     ,    
+struct CheckNode {
+    size_t size;
+    CheckNode* next;
+    CheckNode* prev;
+    size_t slot;
 };
 
-//     
-class MemoryManager {
-private:
-    struct Node {
-        MemoryBlock* block;
-        Node* next;
-        Node* prev;
-
-        Node(MemoryBlock* blk) : block(blk), next(nullptr), prev(nullptr) {}
-    };
-
-    Node* head; //  
-
-public:
-    MemoryManager() : head(nullptr) {}
-
-    ~MemoryManager() {
-        //       
-        Node* current = head;
-        while (current) {
-            Node* next = current->next;
-            delete current->block; //   
-            delete current;        //   
-            current = next;
-        }
-    }
-
-    //      
-    void* allocate(size_t size) {
-        //     
-        Node* current = head;
-        while (current) {
-            if (current->block->size >= size) {
-                //   
-                void* address = current->block->address;
-                //    
-                if (current == head) {
-                    head = current->next;
-                    if (head) head->prev = nullptr;
-                }
-                else {
-                    current->prev->next = current->next;
-                    if (current->next) current->next->prev = current->prev;
-                }
-                delete current->block;
-                delete current;
-                return address;
-            }
-            current = current->next;
-        }
-        //     ,  nullptr
-        return nullptr;
-    }
-    //        
-    void* allocate(size_t size) {
-        Node* current = head;
-        while (current) {
-            if (current->block->size >= size) {
-                //   
-                void* address = current->block->address;
-                //    
-                if (current == head) {
-                    head = current->next;
-                    if (head) head->prev = nullptr;
-                }
-                else {
-                    current->prev->next = current->next;
-                    if (current->next) current->next->prev = current->prev;
-                }
-                delete current->block;
-                delete current;
-                return address;
-            }
-            current = current->next;
+//         ,   : 
+//        ,   .  
+//     (Indexed)      ,   
+//    (Scalar).     64GB,    .
+template <class Scalar, class Indexed>
+size_t crossCheck(unsigned seed) {
+    std::mt19937_64 rng(seed);
+    std::deque<CheckNode> storage; //      
+    CheckNode* head = nullptr;
+    size_t freeCount = 0;
+    Indexed indexed;
+    indexed.reserve(1024);
+    size_t mismatches = 0;
+
+    for (int operation = 0; operation < 50000; ++operation) {
+        if (freeCount < 16 || (freeCount < 1024 && rng() % 2)) {
+            size_t size = rng() % 2000 == 0 ? (size_t(64) << 30) + 16 * (rng() % 1024) : 16 * (2 + rng() % 256);
+            storage.push_back(CheckNode{ size, head, nullptr, 0 });
+            CheckNode* node = &storage.back();
+            if (head)
+                head->prev = node;
+            head = node;
+            indexed.remember(node);
+            ++freeCount;
+            continue;
         }
-        //     ,  nullptr
-        return nullptr;
-    }
-
-    //         
-    void* allocate(size_t size) {
-        Node* current = head;
-        Node* bestFitNode = nullptr;
-        size_t maxBlockSize = 0;
-
-        //     (  >= size)
-        while (current) {
-            if (current->block->size >= size && (bestFitNode == nullptr || current->block->size > maxBlockSize)) {
-                bestFitNode = current;
-                maxBlockSize = current->block->size;
-            }
-            current = current->next;
+        size_t needed = 16 * (2 + rng() % 300);
+        Stats::Probe probe;
+        CheckNode* expected = Scalar().find(head, needed, probe);
+        CheckNode* found = indexed.find(head, needed, probe);
+        if (!expected != !found || (found && found->size != expected->size))
+            ++mismatches;
+        if (!found)
+            continue;
+        if (found->size - needed >= 32) {
+            found->size -= needed;
+            indexed.resized(found);
         }
-
-        if (bestFitNode) {
-            //   
-            void* address = bestFitNode->block->address;
-            //    
-            if (bestFitNode == head) {
-                head = bestFitNode->next;
-                if (head) head->prev = nullptr;
-            }
-            else {
-                bestFitNode->prev->next = bestFitNode->next;
-                if (bestFitNode->next) bestFitNode->next->prev = bestFitNode->prev;
-            }
-            delete bestFitNode->block;
-            delete bestFitNode;
-            return address;
+        else {
+            if (found->prev)
+                found->prev->next = found->next;
+            else
+                head = found->next;
+            if (found->next)
+                found->next->prev = found->prev;
+            indexed.forget(found);
+            --freeCount;
         }
-
-        //     ,  nullptr
-        return nullptr;
     }
+    return mismatches;
+}
 
-    //          
-    void deallocate(void* address, size_t size) {
-        //    
-        MemoryBlock* newBlock = new MemoryBlock(address, size);
-        //         
-        Node* newNode = new Node(newBlock);
-        Node* current = head;
-        while (current) {
-            if (current->block->address > address)
-                break;
-            current = current->next;
-        }
-        if (current == head) {
-            newNode->next = head;
-            if (head) head->prev = newNode;
-            head = newNode;
-        }
-        else {
-            newNode->next = current;
-            newNode->prev = current->prev;
-            current->prev = newNode;
-            if (newNode->prev) newNode->prev->next = newNode;
-        }
+//     freeBlocks  :   (   ),
+//    -         
+template <class Policy>
+double allocateNanoseconds(size_t freeBlocks) {
+    const size_t poolSize = size_t(64) << 20;
+    const size_t probes = 64;
+    const int rounds = 2000;
+    auto manager = std::make_unique<MemoryManager<Policy>>(poolSize);
+
+    std::mt19937 rng(9);
+    std::vector<void*> blocks(2 * freeBlocks);
+    for (void*& block : blocks)
+        block = manager->allocate(64 + rng() % 4000);
+    for (size_t i = 0; i < blocks.size(); i += 2)
+        manager->deallocate(blocks[i]);
+    //   ,      
+    std::vector<void*> tail;
+    while (void* block = manager->allocate(1 << 20))
+        tail.push_back(block);
+
+    std::vector<void*> taken(probes);
+    double total = 0;
+    for (int round = 0; round < rounds; ++round) {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < probes; ++i)
+            taken[i] = manager->allocate(16 + rng() % 2000);
+        auto finish = std::chrono::steady_clock::now();
+        total += std::chrono::duration<double, std::nano>(finish - start).count();
+        for (void* block : taken)
+            manager->deallocate(block);
     }
-};
+    return total / (static_cast<double>(rounds) * probes);
+}
 
 //  
 int main() {
-    MemoryManager manager;
+    //       1MB
+    MemoryManager<> manager(1024 * 1024);
 
     //  
     void* ptr1 = manager.allocate(100);
     void* ptr2 = manager.allocate(50);
     void* ptr3 = manager.allocate(200);
 
+    //    JSON (  - Stats::PeriodicDump   )
+    Stats::writeJson(std::cout, Stats::snapshot(manager), "sorted-list");
+    std::cout << std::endl;
+
     //  
     manager.deallocate(ptr1, 100);
     manager.deallocate(ptr2, 50);
     manager.deallocate(ptr3, 200);
 
-    return 0;
+    //      ,    ,    
+#if defined(SORTED_LIST_INDEX_AVX2)
+    const char* path = "AVX2";
+#elif defined(SORTED_LIST_INDEX_SSE2)
+    const char* path = "SSE2";
+#else
+    const char* path = "scalar";
+#endif
+    size_t bestMismatches = 0, worstMismatches = 0;
+    for (unsigned seed = 1; seed <= 8; ++seed) {
+        bestMismatches += crossCheck<BestFit, IndexedBestFit>(seed);
+        worstMismatches += crossCheck<WorstFit, IndexedWorstFit>(seed);
+    }
+    std::cout << "index cross-check (" << path << "): best-fit mismatches " << bestMismatches
+              << ", worst-fit mismatches " << worstMismatches << std::endl;
+
+    //         
+    std::cout << std::setw(12) << "free blocks" << std::setw(12) << "best" << std::setw(12) << "best/index"
+              << std::setw(12) << "worst" << std::setw(12) << "worst/index" << "   ns/allocate" << std::endl;
+    for (size_t freeBlocks : { 64, 256, 1024, 4096 }) {
+        std::cout << std::fixed << std::setprecision(1) << std::setw(12) << freeBlocks
+                  << std::setw(12) << allocateNanoseconds<BestFit>(freeBlocks)
+                  << std::setw(12) << allocateNanoseconds<IndexedBestFit>(freeBlocks)
+                  << std::setw(12) << allocateNanoseconds<WorstFit>(freeBlocks)
+                  << std::setw(12) << allocateNanoseconds<IndexedWorstFit>(freeBlocks) << std::endl;
+    }
+
+    return bestMismatches == 0 && worstMismatches == 0 ? 0 : 1;
 }
@@ -0,0 +1,405 @@
+//MemoryBlock:    ,            .
+//MemoryManager : ,        (buddy system).
+//MemoryManager(size_t size, const PoolOptions& options) :  ,               .      .
+//~MemoryManager() :  ,    .
+//BestFit, WorstFit :   -   MemoryManager,  ,    .
+//allocate(size_t size) :       .      ( ,      ).     ,    O().
+//deallocate(void* address) :        ,     "",  .       ,   "",      .      .
+//deallocate(void* address, size_t size) :     :        .
+//allocateBatch(size_t size, size_t count, void** out) :     :          .
+//deallocateBatch(void** ptrs, size_t count, size_t size) :      ,        .
+//grow() :      :     ""   .
+//trim() :      .
+//owns(const void* address) :        (   ).
+//getBuddyOffset(size_t offset, int level) :      "" .
+//forEachFreeBlock(Visit visit) :       Stats::snapshot,      ALLOCATOR_STATS.
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include <new>
+#include <bit>
+#include "AllocatorStats.h"
+#include "VirtualMemory.h"
+
+namespace Buddy {
+
+//     (    )
+struct MemoryBlock {
+    MemoryBlock* next; //      
+    MemoryBlock* prev; //      
+};
+
+//  :      ,    
+// (-1,   ).     ,    
+//           .
+
+//       -  countr_zero   
+struct BestFit {
+    int findLevel(uint64_t levelMask, int level) const {
+        uint64_t candidates = levelMask & (~uint64_t(0) << level);
+        return candidates ? std::countr_zero(candidates) : -1;
+    }
+};
+
+//    -   
+struct WorstFit {
+    int findLevel(uint64_t levelMask, int level) const {
+        int top = static_cast<int>(std::bit_width(levelMask)) - 1;
+        return top >= level ? top : -1;
+    }
+};
+
+//          (buddy system)
+template <class Policy = BestFit>
+class MemoryManager {
+public:
+    static const size_t kAlignment = 32;     //         ( -  )
+
+private:
+    static const int kMinLevel = 5;          //   2^5 = kAlignment  ( MemoryBlock)
+    static const int kLevelCount = 64;       //  0..63 -      
+
+    size_t memorySize;      //   
+    int maxLevel;           //    
+    int reserveLevel;       //       
+    size_t releaseThreshold;              //        
+    size_t pendingRelease;                //      
+    VirtualMemory::Region pool;           //   
+    VirtualMemory::Region bitmap;         //    
+    VirtualMemory::Region levelTable;     //    
+    char* poolBegin;                      //   (  )
+    uint64_t* freeBits;                   //       
+    uint8_t* levels;                      //        32- 
+    MemoryBlock* freeLists[kLevelCount];  //     
+    size_t levelBase[kLevelCount];        //      
+    uint64_t levelMask;                   // ,     
+    Policy policy;                        //  
+    ALLOCATOR_STAT(Stats::Counters stats;) //  
+
+public:
+    MemoryManager(size_t size, const VirtualMemory::PoolOptions& options = VirtualMemory::PoolOptions())
+        : memorySize(size), maxLevel(topLevel(size)), reserveLevel(std::max(maxLevel, topLevel(options.reserve))),
+          releaseThreshold(options.releaseThreshold), pendingRelease(0), pool(size_t(1) << reserveLevel, options.hugePages, options.numaNode),
+          bitmap(bitmapWords(reserveLevel) * sizeof(uint64_t), VirtualMemory::HugePages::None, options.numaNode),
+          levelTable(tableBytes(reserveLevel), VirtualMemory::HugePages::None, options.numaNode), levelMask(0) {
+        //     ,       ,
+        //      .        .
+        //   ,       operator new.
+        poolBegin = pool.begin();
+        freeBits = reinterpret_cast<uint64_t*>(bitmap.begin());
+        levels = reinterpret_cast<uint8_t*>(levelTable.begin());
+        std::fill(freeLists, freeLists + kLevelCount, nullptr);
+        std::fill(levelBase, levelBase + kLevelCount, size_t(0));
+        if (maxLevel < kMinLevel) {
+            reserveLevel = maxLevel; //        
+            return;
+        }
+        if (!pool.commit(size_t(1) << maxLevel) || !bitmap.commit(bitmap.reserved()) || !levelTable.commit(tableBytes(maxLevel)))
+            throw std::bad_alloc();
+
+        //   l  2^(reserveLevel - l) ,    
+        size_t bits = 0;
+        for (int level = kMinLevel; level <= reserveLevel; ++level) {
+            levelBase[level] = bits;
+            bits += size_t(1) << (reserveLevel - level);
+        }
+
+        //      
+        pushFree(0, maxLevel);
+    }
+
+    ~MemoryManager() {
+        //         
+    }
+
+    MemoryManager(const MemoryManager&) = delete;
+    MemoryManager& operator=(const MemoryManager&) = delete;
+
+    //       (   )
+    void* allocate(size_t size) {
+        int level = levelFor(size); //   ,      
+        if (level > reserveLevel || level < kMinLevel)
+            return nullptr;
+
+        int l = policy.findLevel(levelMask, level);
+        while (l < 0 && grow())
+            l = policy.findLevel(levelMask, level);
+        //   -    ,    
+        ALLOCATOR_STAT(Stats::Probe probe; probe.steps = l < 0 ? 0 : static_cast<size_t>(l - level));
+        ALLOCATOR_STAT(stats.onAllocate(size, l < 0 ? 0 : size_t(1) << level, probe));
+        if (l < 0)
+            return nullptr; //     
+
+        size_t offset = popFree(l);
+
+        //     ,     ,     
+        while (l > level) {
+            --l;
+            pushFree(offset + (size_t(1) << l), l);
+            ALLOCATOR_STAT(stats.onSplit());
+        }
+
+        levels[offset >> kMinLevel] = static_cast<uint8_t>(level);
+        return poolBegin + offset;
+    }
+
+    //        :  -   
+    void deallocate(void* address) {
+        if (!address)
+            return;
+        size_t offset = static_cast<size_t>(reinterpret_cast<char*>(address) - poolBegin);
+        release(offset, levels[offset >> kMinLevel]);
+    }
+
+    //          
+    void deallocate(void* address, size_t size) {
+        if (!address)
+            return;
+        release(static_cast<size_t>(reinterpret_cast<char*>(address) - poolBegin), levelFor(size));
+    }
+
+    //  count   size  out.       
+    // (  ),         ;
+    //         . 
+    //   .
+    size_t allocateBatch(size_t size, size_t count, void** out) {
+        int level = levelFor(size);
+        if (level > reserveLevel || level < kMinLevel)
+            return 0;
+
+        size_t done = 0;
+        while (done < count) {
+            //     : level + ceil(log2())
+            int batchLevel = std::min(reserveLevel, level + static_cast<int>(std::bit_width(count - done - 1)));
+            int l = findBatchLevel(level, batchLevel);
+            while (l < 0 && grow())
+                l = findBatchLevel(level, batchLevel);
+            ALLOCATOR_STAT(Stats::Probe probe; probe.steps = l < 0 ? 0 : static_cast<size_t>(std::max(l - batchLevel, 0)));
+            ALLOCATOR_STAT(stats.onAllocate(size, l < 0 ? 0 : size_t(1) << level, probe));
+            if (l < 0)
+                break;
+
+            size_t offset = popFree(l);
+            while (l > batchLevel) {
+                --l;
+                pushFree(offset + (size_t(1) << l), l);
+                ALLOCATOR_STAT(stats.onSplit());
+            }
+
+            size_t take = std::min(count - done, size_t(1) << (l - level));
+            for (size_t i = 0; i < take; ++i) {
+                levels[(offset + (i << level)) >> kMinLevel] = static_cast<uint8_t>(level);
+                out[done++] = poolBegin + offset + (i << level);
+                ALLOCATOR_STAT(if (i > 0) stats.onAllocate(size, size_t(1) << level, Stats::Probe()));
+            }
+
+            //  [pos, end)     :  "" 
+            //     ,    
+            size_t pos = offset + (take << level);
+            size_t end = offset + (size_t(1) << l);
+            while (pos < end) {
+                int tail = std::min(std::countr_zero(pos), static_cast<int>(std::bit_width(end - pos)) - 1);
+                pushFree(pos, tail);
+                pos += size_t(1) << tail;
+                ALLOCATOR_STAT(stats.onSplit());
+            }
+        }
+        return done;
+    }
+
+    //  count   size.     ( ptrs
+    // ):  ""      ,
+    //      .          
+    //  O(),   ,       .
+    void deallocateBatch(void** ptrs, size_t count, size_t size) {
+        std::sort(ptrs, ptrs + count, [](void* a, void* b) { return std::less<void*>()(a, b); });
+        for (size_t i = 0; i < count; ++i)
+            deallocate(ptrs[i], size);
+    }
+
+    //      .     ,     
+    bool grow() {
+        if (maxLevel >= reserveLevel || !pool.commit(size_t(1) << (maxLevel + 1)) || !levelTable.commit(tableBytes(maxLevel + 1)))
+            return false;
+        if (testBit(maxLevel, 0)) {
+            removeFree(0, maxLevel);
+            pushFree(0, maxLevel + 1);
+        }
+        else {
+            pushFree(size_t(1) << maxLevel, maxLevel);
+        }
+        ++maxLevel;
+        return true;
+    }
+
+    //       (     )
+    void trim() {
+        releaseFree(0);
+    }
+
+    //      (   )
+    size_t freeBlockCount(int level) const {
+        size_t count = 0;
+        for (MemoryBlock* block = freeLists[level]; block; block = block->next)
+            ++count;
+        return count;
+    }
+
+    int getMaxLevel() const { return maxLevel; }
+
+    //      (   ) -     
+    bool owns(const void* address) const {
+        const char* p = static_cast<const char*>(address);
+        return p >= poolBegin && p < poolBegin + pool.reserved();
+    }
+
+    //      
+    size_t freeBytes() const {
+        size_t total = 0;
+        for (int level = 0; level <= maxLevel; ++level)
+            total += freeBlockCount(level) << level;
+        return total;
+    }
+
+    //     -   
+    size_t largestFreeBlock() const {
+        return levelMask ? size_t(1) << (std::bit_width(levelMask) - 1) : 0;
+    }
+
+    //     , visit(size)  
+    template <class Visit>
+    void forEachFreeBlock(Visit visit) const {
+        for (int level = 0; level <= maxLevel; ++level) {
+            for (MemoryBlock* block = freeLists[level]; block; block = block->next)
+                visit(size_t(1) << level);
+        }
+    }
+
+#ifdef ALLOCATOR_STATS
+    const Stats::Counters& counters() const { return stats; }
+#endif
+
+private:
+    //    level    ""
+    void release(size_t offset, int level) {
+        size_t freed = size_t(1) << level;
+        ALLOCATOR_STAT(stats.onDeallocate(freed));
+
+        //   ,  "" 
+        while (level < maxLevel) {
+            size_t buddyOffset = getBuddyOffset(offset, level);
+            if (!testBit(level, buddyOffset))
+                break;
+            removeFree(buddyOffset, level);
+            offset &= ~(size_t(1) << level);
+            ++level;
+            ALLOCATOR_STAT(stats.onMerge());
+        }
+        pushFree(offset, level);
+
+        //       ,    releaseThreshold
+        //  :      ,    
+        // ,            page fault
+        pendingRelease += freed;
+        if (releaseThreshold && pendingRelease >= releaseThreshold)
+            releaseFree(releaseThreshold);
+    }
+
+    //        minSize -    
+    void releaseFree(size_t minSize) {
+        pendingRelease = 0;
+        for (int level = levelFor(minSize); level <= maxLevel; ++level) {
+            for (MemoryBlock* block = freeLists[level]; block; block = block->next) {
+                char* begin = reinterpret_cast<char*>(block);
+                pool.discard(begin + sizeof(MemoryBlock), begin + (size_t(1) << level));
+            }
+        }
+    }
+
+    //  - :   ,      
+    int findBatchLevel(int level, int batchLevel) const {
+        int l = policy.findLevel(levelMask, batchLevel);
+        return l >= 0 ? l : policy.findLevel(levelMask, level);
+    }
+
+    //      2^level:      
+    static size_t tableBytes(int level) {
+        return level >= kMinLevel ? size_t(1) << (level - kMinLevel) : 1;
+    }
+
+    //    ,   size
+    static int topLevel(size_t size) {
+        return size ? static_cast<int>(std::bit_width(size)) - 1 : 0;
+    }
+
+    //     kMinLevel..level   2^level
+    static size_t bitmapWords(int level) {
+        size_t bits = level >= kMinLevel ? (size_t(1) << (level - kMinLevel + 1)) : 0;
+        return (bits + 63) / 64;
+    }
+
+    //    : ceil(log2(size))   
+    static int levelFor(size_t size) {
+        if (size <= (size_t(1) << kMinLevel))
+            return kMinLevel;
+        return static_cast<int>(std::bit_width(size - 1));
+    }
+
+    MemoryBlock* blockAt(size_t offset) const {
+        return reinterpret_cast<MemoryBlock*>(poolBegin + offset);
+    }
+
+    size_t bitIndex(size_t offset, int level) const {
+        return levelBase[level] + (offset >> level);
+    }
+
+    bool testBit(int level, size_t offset) const {
+        size_t bit = bitIndex(offset, level);
+        return (freeBits[bit / 64] >> (bit % 64)) & 1u;
+    }
+
+    void setBit(int level, size_t offset, bool value) {
+        size_t bit = bitIndex(offset, level);
+        if (value) freeBits[bit / 64] |= uint64_t(1) << (bit % 64);
+        else freeBits[bit / 64] &= ~(uint64_t(1) << (bit % 64));
+    }
+
+    //      
+    void pushFree(size_t offset, int level) {
+        MemoryBlock* block = blockAt(offset);
+        block->prev = nullptr;
+        block->next = freeLists[level];
+        if (block->next) block->next->prev = block;
+        freeLists[level] = block;
+        setBit(level, offset, true);
+        levelMask |= uint64_t(1) << level;
+    }
+
+    //      
+    size_t popFree(int level) {
+        MemoryBlock* block = freeLists[level];
+        size_t offset = static_cast<size_t>(reinterpret_cast<char*>(block) - poolBegin);
+        removeFree(offset, level);
+        return offset;
+    }
+
+    //        O(1)
+    void removeFree(size_t offset, int level) {
+        MemoryBlock* block = blockAt(offset);
+        if (block->prev) block->prev->next = block->next;
+        else freeLists[level] = block->next;
+        if (block->next) block->next->prev = block->prev;
+        setBit(level, offset, false);
+        if (!freeLists[level])
+            levelMask &= ~(uint64_t(1) << level);
+    }
+
+    //      "" 
+    static size_t getBuddyOffset(size_t offset, int level) {
+        return offset ^ (size_t(1) << level);
+    }
+};
+
+} // namespace Buddy
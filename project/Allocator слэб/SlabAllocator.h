@@ -0,0 +1,237 @@
+//SlabAllocator<Manager> :      (16-256 )  MemoryManager     .      .
+//SlabAllocator::Slab :   -     :     ,         .
+//allocate(size_t size) :    .           O(1),    .
+//deallocate(void* address, size_t size) :    .     ,       O(1).      .
+//trim() :   ,    .
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+template <class Manager>
+class SlabAllocator {
+private:
+    //         
+    struct FreeObject {
+        FreeObject* next;
+    };
+
+    //      
+    struct Slab {
+        Slab* next;            //           
+        Slab* prev;
+        FreeObject* freeList;  //   
+        char* bump;            //        
+        uint32_t chunk;        //  ,    
+        uint16_t used;         //  
+        uint16_t capacity;     //   
+        uint16_t objectSize;   //   
+        uint16_t cls;          //  
+    };
+
+    static const size_t kAlignment = 16;
+    static const size_t kSlabSize = 16 * 1024;       //      -    
+    static const size_t kChunkSize = 16 * kSlabSize; // ,      
+    static const size_t kHeaderSize = (sizeof(Slab) + kAlignment - 1) & ~(kAlignment - 1);
+    static const size_t kMaxSmall = 256;             //     
+    static const int kClassCount = 12;
+
+    //  :  16   128,  32   256.     
+    // 15      31    -       .
+    static constexpr uint16_t kClassSizes[kClassCount] = { 16, 32, 48, 64, 80, 96, 112, 128, 160, 192, 224, 256 };
+    //   (size + 15) / 16 -     ceil(log2(size))
+    static constexpr uint8_t kClassOf[kMaxSmall / kAlignment + 1] = { 0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 8, 9, 9, 10, 10, 11, 11 };
+
+    //   kChunkSize   ;  -    
+    struct Chunk {
+        void* raw;       // ,  
+        char* first;     //   
+        size_t slabs;    //    
+        size_t freeSlabs; //      
+    };
+
+    Manager manager;            // ,         
+    Slab* partial[kClassCount]; //      (       )
+    Slab* emptySlabs;           //  ,    
+    std::vector<Chunk> chunks;  //  ,   
+
+public:
+    //     ( ,  )
+    template <class... Args>
+    explicit SlabAllocator(Args&&... args) : manager(std::forward<Args>(args)...), partial(), emptySlabs(nullptr) {}
+
+    ~SlabAllocator() {
+        //          
+    }
+
+    SlabAllocator(const SlabAllocator&) = delete;
+    SlabAllocator& operator=(const SlabAllocator&) = delete;
+
+    //    :   -    ,  -  
+    void* allocate(size_t size) {
+        if (size == 0)
+            return nullptr;
+        if (size > kMaxSmall)
+            return manager.allocate(size);
+
+        int cls = kClassOf[(size + kAlignment - 1) / kAlignment];
+        Slab* slab = partial[cls];
+        if (!slab) {
+            slab = takeEmptySlab(cls);
+            if (!slab)
+                return nullptr;
+        }
+
+        void* object;
+        if (slab->freeList) {
+            object = slab->freeList;
+            slab->freeList = slab->freeList->next;
+        }
+        else {
+            //      ,      
+            object = slab->bump;
+            slab->bump += slab->objectSize;
+        }
+        if (++slab->used == slab->capacity)
+            unlink(partial[cls], slab); //   -      
+        return object;
+    }
+
+    //    ; size -  ,   
+    void deallocate(void* address, size_t size) {
+        if (!address)
+            return;
+        if (size > kMaxSmall) {
+            manager.deallocate(address, size);
+            return;
+        }
+
+        Slab* slab = slabOf(address);
+        FreeObject* object = static_cast<FreeObject*>(address);
+        object->next = slab->freeList;
+        slab->freeList = object;
+
+        Slab*& list = partial[slab->cls];
+        if (slab->used-- == slab->capacity)
+            push(list, slab); //      
+        //     ,     :
+        //             
+        if (slab->used == 0 && (list != slab || slab->next)) {
+            unlink(list, slab);
+            releaseSlab(slab);
+        }
+    }
+
+    //   ,      
+    void trim() {
+        //  ,  ,  
+        for (int cls = 0; cls < kClassCount; ++cls) {
+            for (Slab* slab = partial[cls]; slab; ) {
+                Slab* next = slab->next;
+                if (slab->used == 0) {
+                    unlink(partial[cls], slab);
+                    releaseSlab(slab);
+                }
+                slab = next;
+            }
+        }
+
+        for (size_t i = 0; i < chunks.size(); ) {
+            Chunk& chunk = chunks[i];
+            if (chunk.freeSlabs != chunk.slabs) {
+                ++i;
+                continue;
+            }
+            for (size_t s = 0; s < chunk.slabs; ++s)
+                unlink(emptySlabs, slabAt(chunk, s));
+            manager.deallocate(chunk.raw, kChunkSize);
+
+            //     ,     
+            chunk = chunks.back();
+            chunks.pop_back();
+            if (i < chunks.size()) {
+                for (size_t s = 0; s < chunks[i].slabs; ++s)
+                    slabAt(chunks[i], s)->chunk = static_cast<uint32_t>(i);
+            }
+        }
+    }
+
+    //    (     )
+    Manager& underlying() { return manager; }
+    const Manager& underlying() const { return manager; }
+
+    // ,     
+    size_t slabBytes() const { return chunks.size() * kChunkSize; }
+
+private:
+    static Slab* slabOf(void* address) {
+        return reinterpret_cast<Slab*>(reinterpret_cast<uintptr_t>(address) & ~static_cast<uintptr_t>(kSlabSize - 1));
+    }
+
+    static Slab* slabAt(const Chunk& chunk, size_t index) {
+        return reinterpret_cast<Slab*>(chunk.first + index * kSlabSize);
+    }
+
+    static void push(Slab*& list, Slab* slab) {
+        slab->prev = nullptr;
+        slab->next = list;
+        if (list) list->prev = slab;
+        list = slab;
+    }
+
+    static void unlink(Slab*& list, Slab* slab) {
+        if (slab->prev) slab->prev->next = slab->next;
+        else list = slab->next;
+        if (slab->next) slab->next->prev = slab->prev;
+    }
+
+    //      ,      trim
+    void releaseSlab(Slab* slab) {
+        push(emptySlabs, slab);
+        ++chunks[slab->chunk].freeSlabs;
+    }
+
+    //     cls;       
+    Slab* takeEmptySlab(int cls) {
+        if (!emptySlabs && !addChunk())
+            return nullptr;
+        Slab* slab = emptySlabs;
+        unlink(emptySlabs, slab);
+        --chunks[slab->chunk].freeSlabs;
+
+        slab->freeList = nullptr;
+        slab->bump = reinterpret_cast<char*>(slab) + kHeaderSize;
+        slab->used = 0;
+        slab->objectSize = kClassSizes[cls];
+        slab->capacity = static_cast<uint16_t>((kSlabSize - kHeaderSize) / slab->objectSize);
+        slab->cls = static_cast<uint16_t>(cls);
+        push(partial[cls], slab);
+        return slab;
+    }
+
+    //  :      ,   
+    //  ,     (1/16 )
+    bool addChunk() {
+        void* raw = manager.allocate(kChunkSize);
+        if (!raw)
+            return false;
+        uintptr_t begin = reinterpret_cast<uintptr_t>(raw);
+        uintptr_t first = (begin + kSlabSize - 1) & ~static_cast<uintptr_t>(kSlabSize - 1);
+
+        Chunk chunk;
+        chunk.raw = raw;
+        chunk.first = reinterpret_cast<char*>(first);
+        chunk.slabs = (begin + kChunkSize - first) / kSlabSize;
+        chunk.freeSlabs = 0;
+        chunks.push_back(chunk);
+
+        uint32_t index = static_cast<uint32_t>(chunks.size() - 1);
+        for (size_t s = chunk.slabs; s-- > 0; ) {
+            Slab* slab = slabAt(chunk, s);
+            slab->chunk = index;
+            releaseSlab(slab);
+        }
+        return true;
+    }
+};
@@ -0,0 +1,92 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cassert>
+#include "SlabAllocator.h"
+#include "BuddyManager.h"
+#include "BoundaryTagManager.h"
+
+//     : ,       
+template <class Manager>
+size_t usedBytes(const Manager& manager, size_t poolSize) {
+    return poolSize - Stats::snapshot(manager).freeBytes;
+}
+
+template <class Manager>
+Manager& poolOf(Manager& manager) { return manager; }
+
+template <class Manager>
+Manager& poolOf(SlabAllocator<Manager>& slab) { return slab.underlying(); }
+
+//   16-256 :  ,    ,  .
+//            .
+template <class Allocator>
+void runSmallObjects(const char* name, size_t poolSize) {
+    const size_t objects = 200000;
+    const int rounds = 10;
+    auto allocator = std::make_unique<Allocator>(poolSize);
+
+    std::mt19937 rng(3);
+    std::vector<size_t> sizes(objects);
+    size_t requested = 0;
+    for (size_t& size : sizes) {
+        size = 16 + rng() % 241;
+        requested += size;
+    }
+    std::vector<size_t> order(objects);
+    for (size_t i = 0; i < objects; ++i)
+        order[i] = i;
+    std::shuffle(order.begin(), order.end(), rng);
+
+    std::vector<void*> pointers(objects);
+    size_t used = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; ++round) {
+        for (size_t i = 0; i < objects; ++i)
+            pointers[i] = allocator->allocate(sizes[i]);
+        if (round == 0)
+            used = usedBytes(poolOf(*allocator), poolSize);
+        for (size_t i : order)
+            allocator->deallocate(pointers[i], sizes[i]);
+    }
+    auto finish = std::chrono::steady_clock::now();
+
+    double operations = 2.0 * rounds * objects;
+    std::cout << std::left << std::setw(20) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << operations / std::chrono::duration<double, std::micro>(finish - start).count()
+              << std::setw(12) << static_cast<double>(used) / requested << std::endl;
+}
+
+//  
+int main() {
+    //       1MB
+    SlabAllocator<Buddy::MemoryManager<>> allocator(1024 * 1024);
+
+    //     ,   -  
+    void* ptr1 = allocator.allocate(50);
+    void* ptr2 = allocator.allocate(50);
+    void* ptr3 = allocator.allocate(5000);
+    assert(static_cast<char*>(ptr2) - static_cast<char*>(ptr1) == 64 || static_cast<char*>(ptr1) - static_cast<char*>(ptr2) == 64);
+
+    allocator.deallocate(ptr1, 50);
+    allocator.deallocate(ptr2, 50);
+    allocator.deallocate(ptr3, 5000);
+
+    //      
+    allocator.trim();
+    assert(allocator.slabBytes() == 0);
+
+    const size_t poolSize = size_t(64) << 20;
+    std::cout << std::left << std::setw(20) << "allocator" << std::right << std::setw(10) << "Mops/s"
+              << std::setw(12) << "pool/req" << std::endl;
+    runSmallObjects<Buddy::MemoryManager<>>("buddy", poolSize);
+    runSmallObjects<SlabAllocator<Buddy::MemoryManager<>>>("slab/buddy", poolSize);
+    runSmallObjects<BoundaryTags::MemoryManager<>>("boundary-tags", poolSize);
+    runSmallObjects<SlabAllocator<BoundaryTags::MemoryManager<>>>("slab/boundary-tags", poolSize);
+
+    return 0;
+}
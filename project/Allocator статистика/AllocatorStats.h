@@ -0,0 +1,226 @@
+//Counters :      ( ,     ): , ,  ,    ,      .
+//Probe :      .        .
+//Snapshot :  :       ( ,  ,      , ).
+//snapshot(const Manager& manager) :           .
+//writeJson(std::ostream& out, const Snapshot& snapshot, const char* name) :     JSON.
+//PeriodicDump :        .
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <ostream>
+#include <bit>
+
+//    ALLOCATOR_STATS    .  
+// ,            ,  
+//    ,      .
+#ifdef ALLOCATOR_STATS
+#define ALLOCATOR_STAT(...) __VA_ARGS__
+#else
+#define ALLOCATOR_STAT(...)
+#endif
+
+namespace Stats {
+
+static const int kSizeClasses = 32;    //   - ceil(log2(size)),   2^31 -   
+static const int kSearchBuckets = 16;  //    - bit_width(): 0, 1, 2-3, 4-7, ...
+
+inline int sizeClass(size_t size) {
+    int c = size > 1 ? static_cast<int>(std::bit_width(size - 1)) : 0;
+    return c < kSizeClasses ? c : kSizeClasses - 1;
+}
+
+inline int searchBucket(size_t steps) {
+    int b = static_cast<int>(std::bit_width(steps));
+    return b < kSearchBuckets ? b : kSearchBuckets - 1;
+}
+
+#ifdef ALLOCATOR_STATS
+
+//  :     ,      
+struct Probe {
+    size_t steps = 0;
+    void step() { ++steps; }
+};
+
+//  ,       ,   .  
+//    (     ),   - relaxed
+//       RMW.     .
+struct Counters {
+    std::atomic<uint64_t> allocations{ 0 };   //  
+    std::atomic<uint64_t> failures{ 0 };      // ,  nullptr
+    std::atomic<uint64_t> deallocations{ 0 }; // 
+    std::atomic<uint64_t> liveBytes{ 0 };     //    (   )
+    std::atomic<uint64_t> peakLiveBytes{ 0 }; //  liveBytes
+    std::atomic<uint64_t> splits{ 0 };        //     
+    std::atomic<uint64_t> merges{ 0 };        //     
+    std::atomic<uint64_t> sizeClasses[kSizeClasses] = {};     //    
+    std::atomic<uint64_t> searchLengths[kSearchBuckets] = {}; //    
+
+    // size -   ( ), blockSize -  , 0 -   .
+    //     ,         .
+    void onAllocate(size_t size, size_t blockSize, const Probe& probe) {
+        add(searchLengths[searchBucket(probe.steps)], 1);
+        if (!blockSize) {
+            add(failures, 1);
+            return;
+        }
+        add(allocations, 1);
+        add(sizeClasses[sizeClass(size)], 1);
+        uint64_t live = add(liveBytes, blockSize);
+        if (live > peakLiveBytes.load(std::memory_order_relaxed))
+            peakLiveBytes.store(live, std::memory_order_relaxed);
+    }
+
+    void onDeallocate(size_t blockSize) {
+        add(deallocations, 1);
+        liveBytes.store(liveBytes.load(std::memory_order_relaxed) - blockSize, std::memory_order_relaxed);
+    }
+
+    void onSplit() { add(splits, 1); }
+    void onMerge() { add(merges, 1); }
+
+private:
+    //   :      lock add / lock cmpxchg
+    static uint64_t add(std::atomic<uint64_t>& counter, uint64_t value) {
+        uint64_t result = counter.load(std::memory_order_relaxed) + value;
+        counter.store(result, std::memory_order_relaxed);
+        return result;
+    }
+};
+
+#else
+
+struct Probe {
+    void step() {}
+};
+
+#endif
+
+//    
+struct Snapshot {
+    uint64_t allocations = 0;
+    uint64_t failures = 0;
+    uint64_t deallocations = 0;
+    uint64_t liveBytes = 0;
+    uint64_t peakLiveBytes = 0;
+    uint64_t splits = 0;
+    uint64_t merges = 0;
+    uint64_t sizeClasses[kSizeClasses] = {};
+    uint64_t searchLengths[kSearchBuckets] = {};
+
+    size_t freeBytes = 0;                       //    
+    size_t largestFreeBlock = 0;                //   
+    size_t freeBlocks = 0;                      //   
+    size_t freeBlockClasses[kSizeClasses] = {}; //     
+    double fragmentation = 0;                   //   1 - largest/free
+};
+
+//  .     :  -
+//  (   ),      .
+template <class Manager>
+Snapshot snapshot(const Manager& manager) {
+    Snapshot s;
+#ifdef ALLOCATOR_STATS
+    const Counters& c = manager.counters();
+    s.allocations = c.allocations.load(std::memory_order_relaxed);
+    s.failures = c.failures.load(std::memory_order_relaxed);
+    s.deallocations = c.deallocations.load(std::memory_order_relaxed);
+    s.liveBytes = c.liveBytes.load(std::memory_order_relaxed);
+    s.peakLiveBytes = c.peakLiveBytes.load(std::memory_order_relaxed);
+    s.splits = c.splits.load(std::memory_order_relaxed);
+    s.merges = c.merges.load(std::memory_order_relaxed);
+    for (int i = 0; i < kSizeClasses; ++i)
+        s.sizeClasses[i] = c.sizeClasses[i].load(std::memory_order_relaxed);
+    for (int i = 0; i < kSearchBuckets; ++i)
+        s.searchLengths[i] = c.searchLengths[i].load(std::memory_order_relaxed);
+#endif
+    manager.forEachFreeBlock([&s](size_t size) {
+        ++s.freeBlocks;
+        s.freeBytes += size;
+        ++s.freeBlockClasses[sizeClass(size)];
+        if (size > s.largestFreeBlock)
+            s.largestFreeBlock = size;
+    });
+    s.fragmentation = s.freeBytes ? 1.0 - static_cast<double>(s.largestFreeBlock) / s.freeBytes : 0.0;
+    return s;
+}
+
+namespace Detail {
+//  JSON  : ,       
+inline void writeString(std::ostream& out, const char* text) {
+    static const char* hex = "0123456789abcdef";
+    out << '"';
+    for (const char* c = text; *c; ++c) {
+        unsigned char ch = static_cast<unsigned char>(*c);
+        if (ch == '"' || ch == '\\')
+            out << '\\' << *c;
+        else if (ch < 0x20)
+            out << "\\u00" << hex[ch >> 4] << hex[ch & 15];
+        else
+            out << *c;
+    }
+    out << '"';
+}
+
+template <class T>
+void writeArray(std::ostream& out, const char* key, const T* values, int count) {
+    out << ",\"" << key << "\":[";
+    for (int i = 0; i < count; ++i)
+        out << (i ? "," : "") << values[i];
+    out << ']';
+}
+} // namespace Detail
+
+//    JSON; i-    -   (2^(i-1), 2^i],
+// i-    -   [2^(i-1), 2^i) 
+inline void writeJson(std::ostream& out, const Snapshot& s, const char* name = nullptr) {
+    out << '{';
+    if (name) {
+        out << "\"name\":";
+        Detail::writeString(out, name);
+        out << ',';
+    }
+    out << "\"allocations\":" << s.allocations
+        << ",\"failures\":" << s.failures
+        << ",\"deallocations\":" << s.deallocations
+        << ",\"live_bytes\":" << s.liveBytes
+        << ",\"peak_live_bytes\":" << s.peakLiveBytes
+        << ",\"splits\":" << s.splits
+        << ",\"merges\":" << s.merges
+        << ",\"free_bytes\":" << s.freeBytes
+        << ",\"largest_free_block\":" << s.largestFreeBlock
+        << ",\"free_blocks\":" << s.freeBlocks
+        << ",\"fragmentation\":" << s.fragmentation;
+    Detail::writeArray(out, "size_classes", s.sizeClasses, kSizeClasses);
+    Detail::writeArray(out, "search_lengths", s.searchLengths, kSearchBuckets);
+    Detail::writeArray(out, "free_block_classes", s.freeBlockClasses, kSizeClasses);
+    out << '}';
+}
+
+//  : poll        
+//  JSON,       
+class PeriodicDump {
+public:
+    PeriodicDump(std::ostream& out, std::chrono::milliseconds interval)
+        : out(out), interval(interval), next(std::chrono::steady_clock::now()) {}
+
+    template <class Manager>
+    bool poll(const Manager& manager, const char* name) {
+        auto now = std::chrono::steady_clock::now();
+        if (now < next)
+            return false;
+        next = now + interval;
+        writeJson(out, snapshot(manager), name);
+        out << '\n';
+        return true;
+    }
+
+private:
+    std::ostream& out;
+    std::chrono::milliseconds interval;
+    std::chrono::steady_clock::time_point next;
+};
+
+} // namespace Stats
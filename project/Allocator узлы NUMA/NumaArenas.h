@@ -0,0 +1,307 @@
+//Numa::Topology :  NUMA ,    ,     (Linux - /sys/devices/system/node, Windows - GetNumaHighestNodeNumber).  NUMA -     .     0, nodeId     .
+//Numa::currentNode() :  ,     .
+//Numa::homeNode() :     : currentNode,    kRecheck ,  ,     bindThread.
+//Numa::bindThread(int node) :      .
+//Numa::pageNode(const void* address) : ,      ; -1 -       .
+//Numa::NodeArenas<Manager> :    ( ,  )   ,        .    NUMA -      .     .
+//allocate(size_t size) :      ;      -     .
+//allocateOn(int node, size_t size) :     .
+//deallocate(void* address) :   ,   ,    .
+//nodeOf(const void* address) : ,   ; -1 -    .
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "VirtualMemory.h"
+
+#ifdef _WIN32
+#include <psapi.h>
+#else
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace Numa {
+
+class Topology {
+public:
+    static const Topology& system() {
+        static const Topology topology;
+        return topology;
+    }
+
+    int nodeCount() const { return static_cast<int>(nodes.size()); }
+    bool numa() const { return nodes.size() > 1; }
+    int nodeId(int node) const { return nodes[node].id; }
+    const std::vector<int>& cpus(int node) const { return nodes[node].cpus; }
+
+    //      ; -1 -     
+    int nodeById(int id) const {
+        for (size_t node = 0; node < nodes.size(); ++node) {
+            if (nodes[node].id == id)
+                return static_cast<int>(node);
+        }
+        return -1;
+    }
+
+    //  ;   (  )    0
+    int nodeOfCpu(int cpu) const {
+        return cpu >= 0 && static_cast<size_t>(cpu) < cpuNodes.size() ? cpuNodes[cpu] : 0;
+    }
+
+private:
+    struct Node {
+        int id;                //    
+        std::vector<int> cpus; //  
+    };
+
+    std::vector<Node> nodes;    //   
+    std::vector<int> cpuNodes;  //   
+
+    Topology() {
+#ifdef _WIN32
+        ULONG highest = 0;
+        if (GetNumaHighestNodeNumber(&highest)) {
+            for (USHORT id = 0; id <= highest; ++id) {
+                GROUP_AFFINITY affinity;
+                if (!GetNumaNodeProcessorMaskEx(id, &affinity) || !affinity.Mask)
+                    continue;
+                //      64
+                Node node{ id, {} };
+                for (int bit = 0; bit < 64; ++bit) {
+                    if (affinity.Mask & (KAFFINITY(1) << bit))
+                        node.cpus.push_back(affinity.Group * 64 + bit);
+                }
+                nodes.push_back(node);
+            }
+        }
+#else
+        std::string online;
+        if (readLine("/sys/devices/system/node/online", online)) {
+            for (int id : parseList(online)) {
+                std::string cpus;
+                if (readLine("/sys/devices/system/node/node" + std::to_string(id) + "/cpulist", cpus) && !parseList(cpus).empty())
+                    nodes.push_back(Node{ id, parseList(cpus) });
+            }
+        }
+#endif
+        if (nodes.empty()) {
+            //   NUMA :     
+            Node node{ 0, {} };
+            for (unsigned cpu = 0; cpu < std::max(1u, std::thread::hardware_concurrency()); ++cpu)
+                node.cpus.push_back(static_cast<int>(cpu));
+            nodes.push_back(node);
+        }
+        for (size_t node = 0; node < nodes.size(); ++node) {
+            for (int cpu : nodes[node].cpus) {
+                if (static_cast<size_t>(cpu) >= cpuNodes.size())
+                    cpuNodes.resize(cpu + 1, 0);
+                cpuNodes[cpu] = static_cast<int>(node);
+            }
+        }
+    }
+
+#ifndef _WIN32
+    static bool readLine(const std::string& path, std::string& line) {
+        std::ifstream file(path);
+        return file && std::getline(file, line) && !line.empty();
+    }
+
+    //   "0-3,8,10-11"
+    static std::vector<int> parseList(const std::string& text) {
+        std::vector<int> values;
+        size_t position = 0;
+        while (position < text.size()) {
+            size_t end = text.find(',', position);
+            if (end == std::string::npos)
+                end = text.size();
+            std::string range = text.substr(position, end - position);
+            size_t dash = range.find('-');
+            try {
+                int first = std::stoi(range.substr(0, dash));
+                int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+                for (int value = first; value <= last; ++value)
+                    values.push_back(value);
+            }
+            catch (const std::exception&) {
+                //     
+            }
+            position = end + 1;
+        }
+        return values;
+    }
+#endif
+};
+
+inline int currentNode() {
+    const Topology& topology = Topology::system();
+    if (!topology.numa())
+        return 0;
+#ifdef _WIN32
+    PROCESSOR_NUMBER processor;
+    GetCurrentProcessorNumberEx(&processor);
+    USHORT id = 0;
+    if (!GetNumaProcessorNodeEx(&processor, &id))
+        return 0;
+    int node = topology.nodeById(id);
+    return node < 0 ? 0 : node;
+#else
+    return topology.nodeOfCpu(sched_getcpu());
+#endif
+}
+
+//  ,    
+struct ThreadNode {
+    int node = -1;          // ; -1 -   
+    unsigned countdown = 0; //    
+    bool bound = false;     //       
+};
+
+inline ThreadNode& threadNode() {
+    static thread_local ThreadNode state;
+    return state;
+}
+
+// ,    ,   ;     kRecheck
+// ,       
+static const unsigned kRecheck = 1024;
+
+inline int homeNode() {
+    ThreadNode& state = threadNode();
+    if (!state.bound && state.countdown-- == 0) {
+        state.node = currentNode();
+        state.countdown = kRecheck;
+    }
+    return state.node;
+}
+
+//      ; false -  ,    
+inline bool bindThread(int node) {
+    const Topology& topology = Topology::system();
+    if (node < 0 || node >= topology.nodeCount())
+        return false;
+#ifdef _WIN32
+    GROUP_AFFINITY affinity = {};
+    if (!GetNumaNodeProcessorMaskEx(static_cast<USHORT>(topology.nodeId(node)), &affinity)
+        || !SetThreadGroupAffinity(GetCurrentThread(), &affinity, nullptr))
+        return false;
+#else
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : topology.cpus(node))
+        CPU_SET(cpu, &set);
+    if (sched_setaffinity(0, sizeof(set), &set) != 0)
+        return false;
+#endif
+    ThreadNode& state = threadNode();
+    state.node = node;
+    state.bound = true;
+    return true;
+}
+
+inline int pageNode(const void* address) {
+    const Topology& topology = Topology::system();
+#ifdef _WIN32
+    PSAPI_WORKING_SET_EX_INFORMATION info = {};
+    info.VirtualAddress = const_cast<void*>(address);
+    if (!QueryWorkingSetEx(GetCurrentProcess(), &info, sizeof(info)) || !info.VirtualAttributes.Valid)
+        return -1;
+    return topology.nodeById(static_cast<int>(info.VirtualAttributes.Node));
+#else
+    // move_pages     ,   
+    void* page = const_cast<void*>(address);
+    int status = -1;
+    if (syscall(SYS_move_pages, 0, 1, &page, nullptr, &status, 0) != 0 || status < 0)
+        return -1;
+    return topology.nodeById(status);
+#endif
+}
+
+template <class Manager>
+class NodeArenas {
+private:
+    //  ;          
+    struct alignas(64) Arena {
+        std::mutex lock;
+        Manager manager;
+
+        Arena(size_t size, const VirtualMemory::PoolOptions& options) : manager(size, options) {}
+    };
+
+    std::vector<std::unique_ptr<Arena>> arenas; //   
+
+public:
+    //    - size  (    -  options);  options  
+    explicit NodeArenas(size_t size, VirtualMemory::PoolOptions options = VirtualMemory::PoolOptions()) {
+        const Topology& topology = Topology::system();
+        for (int node = 0; node < topology.nodeCount(); ++node) {
+            options.numaNode = topology.numa() ? topology.nodeId(node) : VirtualMemory::kAnyNode;
+            arenas.push_back(std::make_unique<Arena>(size, options));
+        }
+    }
+
+    NodeArenas(const NodeArenas&) = delete;
+    NodeArenas& operator=(const NodeArenas&) = delete;
+
+    void* allocate(size_t size) {
+        int count = arenaCount();
+        int home = count > 1 ? homeNode() : 0;
+        for (int i = 0; i < count; ++i) {
+            //    -   ,  
+            if (void* address = allocateOn((home + i) % count, size))
+                return address;
+        }
+        return nullptr;
+    }
+
+    void* allocateOn(int node, size_t size) {
+        Arena& arena = *arenas[node];
+        std::lock_guard<std::mutex> guard(arena.lock);
+        return arena.manager.allocate(size);
+    }
+
+    //      ,       
+    void deallocate(void* address) {
+        int node = nodeOf(address);
+        if (node < 0)
+            return;
+        Arena& arena = *arenas[node];
+        std::lock_guard<std::mutex> guard(arena.lock);
+        arena.manager.deallocate(address);
+    }
+
+    void deallocate(void* address, size_t size) {
+        int node = nodeOf(address);
+        if (node < 0)
+            return;
+        Arena& arena = *arenas[node];
+        std::lock_guard<std::mutex> guard(arena.lock);
+        arena.manager.deallocate(address, size);
+    }
+
+    int nodeOf(const void* address) const {
+        if (!address)
+            return -1;
+        for (size_t node = 0; node < arenas.size(); ++node) {
+            if (arenas[node]->manager.owns(address))
+                return static_cast<int>(node);
+        }
+        return -1;
+    }
+
+    int arenaCount() const { return static_cast<int>(arenas.size()); }
+
+    //    ;   -      
+    Manager& arena(int node) { return arenas[node]->manager; }
+    const Manager& arena(int node) const { return arenas[node]->manager; }
+};
+
+} // namespace Numa
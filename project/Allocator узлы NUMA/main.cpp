@@ -0,0 +1,137 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+#include "NumaArenas.h"
+#include "BuddyManager.h"
+#include "BoundaryTagManager.h"
+
+using Clock = std::chrono::steady_clock;
+
+static const size_t kArenaSize = size_t(1) << 30;   //   ;  -   
+static const size_t kBufferSize = size_t(256) << 20; //     
+
+//      ,    allocate  ,   
+//            
+template <class Manager>
+bool checkRouting(const char* label) {
+    Numa::NodeArenas<Manager> arenas(kArenaSize);
+    const Numa::Topology& topology = Numa::Topology::system();
+    std::vector<int> routed(topology.nodeCount()), placed(topology.nodeCount());
+    std::vector<std::vector<void*>> live(topology.nodeCount());
+    std::vector<std::thread> threads;
+    for (int node = 0; node < topology.nodeCount(); ++node) {
+        threads.emplace_back([&, node] {
+            if (topology.numa())
+                Numa::bindThread(node);
+            std::mt19937 rng(node + 1);
+            for (int i = 0; i < 4096; ++i) {
+                size_t size = 64 + rng() % 65536;
+                void* block = arenas.allocate(size);
+                std::memset(block, 1, size);
+                routed[node] += arenas.nodeOf(block) == node;
+                placed[node] += Numa::pageNode(block) == node;
+                live[node].push_back(block);
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+
+    //      -     
+    threads.clear();
+    for (int node = 0; node < topology.nodeCount(); ++node) {
+        threads.emplace_back([&, node] {
+            if (topology.numa())
+                Numa::bindThread(node);
+            for (void* block : live[(node + 1) % topology.nodeCount()])
+                arenas.deallocate(block);
+        });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+
+    bool ok = true;
+    for (int node = 0; node < topology.nodeCount(); ++node) {
+        std::cout << std::left << std::setw(16) << label << std::right << std::setw(6) << node
+                  << std::setw(10) << live[node].size() << std::setw(10) << routed[node] << std::setw(10) << placed[node] << std::endl;
+        ok = ok && routed[node] == static_cast<int>(live[node].size());
+        ok = ok && arenas.arena(node).freeBytes() == arenas.arena(node).largestFreeBlock();
+    }
+    return ok;
+}
+
+//         memoryNode   cpuNode, /
+struct Bandwidth {
+    double write;
+    double read;
+};
+
+static Bandwidth measure(Numa::NodeArenas<Buddy::MemoryManager<>>& arenas, int cpuNode, int memoryNode) {
+    Bandwidth result{ 0, 0 };
+    std::thread worker([&] {
+        if (Numa::Topology::system().numa())
+            Numa::bindThread(cpuNode);
+        uint64_t* buffer = static_cast<uint64_t*>(arenas.allocateOn(memoryNode, kBufferSize));
+        size_t words = kBufferSize / sizeof(uint64_t);
+        std::memset(buffer, 0, kBufferSize); //  :     
+        volatile uint64_t sink = 0;
+        for (int pass = 0; pass < 3; ++pass) {
+            auto start = Clock::now();
+            std::memset(buffer, pass + 1, kBufferSize);
+            double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+            result.write = std::max(result.write, kBufferSize / seconds / 1e9);
+
+            start = Clock::now();
+            uint64_t sum[4] = {};
+            for (size_t i = 0; i < words; i += 4) {
+                sum[0] += buffer[i];
+                sum[1] += buffer[i + 1];
+                sum[2] += buffer[i + 2];
+                sum[3] += buffer[i + 3];
+            }
+            seconds = std::chrono::duration<double>(Clock::now() - start).count();
+            sink = sink + sum[0] + sum[1] + sum[2] + sum[3];
+            result.read = std::max(result.read, kBufferSize / seconds / 1e9);
+        }
+        arenas.deallocate(buffer);
+    });
+    worker.join();
+    return result;
+}
+
+int main() {
+    const Numa::Topology& topology = Numa::Topology::system();
+    std::cout << "NUMA nodes: " << topology.nodeCount() << (topology.numa() ? "" : " (no NUMA: single arena, OS placement)") << std::endl;
+    for (int node = 0; node < topology.nodeCount(); ++node)
+        std::cout << "  node " << node << " (os " << topology.nodeId(node) << "): " << topology.cpus(node).size() << " cpus" << std::endl;
+
+    // :       ,    
+    std::cout << std::left << std::setw(16) << "manager" << std::right << std::setw(6) << "node" << std::setw(10) << "blocks"
+              << std::setw(10) << "routed" << std::setw(10) << "placed" << std::endl;
+    bool ok = checkRouting<Buddy::MemoryManager<>>("buddy");
+    ok = checkRouting<BoundaryTags::MemoryManager<>>("boundary tags") && ok;
+
+    //   :   ()      ().
+    //  -  ,  - .
+    Numa::NodeArenas<Buddy::MemoryManager<>> arenas(kArenaSize);
+    std::cout << "bandwidth GB/s, write/read, " << kBufferSize / (1024 * 1024) << "MB buffer" << std::endl << std::setw(10) << "cpu\\mem";
+    for (int memoryNode = 0; memoryNode < topology.nodeCount(); ++memoryNode)
+        std::cout << std::setw(16) << memoryNode;
+    std::cout << std::endl;
+    for (int cpuNode = 0; cpuNode < topology.nodeCount(); ++cpuNode) {
+        std::cout << std::setw(10) << cpuNode;
+        for (int memoryNode = 0; memoryNode < topology.nodeCount(); ++memoryNode) {
+            Bandwidth bandwidth = measure(arenas, cpuNode, memoryNode);
+            std::cout << std::fixed << std::setprecision(1) << std::setw(10) << bandwidth.write << " /" << std::setw(4) << bandwidth.read;
+        }
+        std::cout << std::endl;
+    }
+    std::cout << (ok ? "ok" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,225 @@
+//Relocatable::Handle :   -       .     ,    ;         .
+//Relocatable::HandleHeap<Manager> :            .    :      ,        .
+//allocate(size_t size) / deallocate(Handle handle) :    . allocate   ,       .
+//get(Handle handle) :   .      compact.
+//pin(Handle handle) / unpin(Handle handle) / HandleHeap::Pin :         -     .
+//compact(size_t budget) :  :            ,      budget .        ,      .   :       .
+//fragmentation() :  : 1 -    /   .
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Relocatable {
+
+//  ;  0 -  
+struct Handle {
+    uint32_t index = 0;      //   
+    uint32_t generation = 0; //     
+
+    explicit operator bool() const { return generation != 0; }
+    bool operator==(const Handle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const Handle& other) const { return !(*this == other); }
+};
+
+//      .         :
+//        ,      .
+struct CompactionReport {
+    size_t bytesMoved = 0;           //   (   )
+    size_t blocksMoved = 0;          //  
+    size_t steps = 0;                //   
+    double fragmentationBefore = 0;  //    
+    double fragmentationAfter = 0;   //     (,  passFinished)
+    bool passFinished = false;       //     
+};
+
+template <class Manager>
+class HandleHeap {
+private:
+    //   
+    struct Slot {
+        void* address;       //     (  -  ); nullptr -  
+        size_t size;         //  
+        uint32_t generation; //    ,    
+        uint32_t pins;       //  
+        uint32_t nextFree;   //   
+    };
+
+    static const uint32_t kNoSlot = UINT32_MAX;
+    static const size_t kPrefix = Manager::kAlignment; //    ,   
+    static const size_t kVisitCost = 64;               //         
+
+    Manager manager;          // ,     
+    std::vector<Slot> slots;  //  
+    uint32_t freeSlots;       //   
+    size_t liveBlocks;        //  
+    bool passActive;          //   
+    Handle last;              //    ;  -     
+    CompactionReport pass;    //   
+
+public:
+    //      
+    class Pin {
+    public:
+        Pin(HandleHeap& heap, Handle handle) : heap(heap), handle(handle) { heap.pin(handle); }
+        ~Pin() { heap.unpin(handle); }
+
+        Pin(const Pin&) = delete;
+        Pin& operator=(const Pin&) = delete;
+
+        void* get() const { return heap.get(handle); }
+
+    private:
+        HandleHeap& heap;
+        Handle handle;
+    };
+
+    //     ( ,  )
+    template <class... Args>
+    explicit HandleHeap(Args&&... args)
+        : manager(std::forward<Args>(args)...), freeSlots(kNoSlot), liveBlocks(0), passActive(false) {}
+
+    HandleHeap(const HandleHeap&) = delete;
+    HandleHeap& operator=(const HandleHeap&) = delete;
+
+    Handle allocate(size_t size) {
+        if (size == 0 || size > SIZE_MAX - kPrefix)
+            return Handle();
+        //    :     ,       .
+        // ,    ,    .
+        if (freeSlots == kNoSlot) {
+            slots.push_back(Slot{ nullptr, 0, 1, 0, kNoSlot });
+            freeSlots = static_cast<uint32_t>(slots.size() - 1);
+        }
+        void* address = manager.allocate(size + kPrefix);
+        if (!address)
+            return Handle();
+
+        uint32_t index = freeSlots;
+        Slot& slot = slots[index];
+        freeSlots = slot.nextFree;
+        *static_cast<uint32_t*>(address) = index;
+        slot.address = address;
+        slot.size = size;
+        slot.pins = 0;
+        ++liveBlocks;
+        return Handle{ index, slot.generation };
+    }
+
+    //     ,  deallocate(nullptr).   
+    //   ,     :       .
+    void deallocate(Handle handle) {
+        Slot* slot = find(handle);
+        if (!slot)
+            return;
+        if (passActive && handle == last)
+            last = Handle();
+        manager.deallocate(slot->address, slot->size + kPrefix);
+        slot->address = nullptr;
+        if (++slot->generation == 0)
+            slot->generation = 1;
+        slot->nextFree = freeSlots;
+        freeSlots = handle.index;
+        --liveBlocks;
+    }
+
+    void* get(Handle handle) const {
+        const Slot* slot = find(handle);
+        return slot ? static_cast<char*>(slot->address) + kPrefix : nullptr;
+    }
+
+    size_t size(Handle handle) const {
+        const Slot* slot = find(handle);
+        return slot ? slot->size : 0;
+    }
+
+    void pin(Handle handle) {
+        if (Slot* slot = find(handle))
+            ++slot->pins;
+    }
+
+    //     :          
+    //  ,      
+    void unpin(Handle handle) {
+        Slot* slot = find(handle);
+        if (slot && slot->pins)
+            --slot->pins;
+    }
+
+    //  .        :    
+    //     ,         
+    // ,         ,   
+    //     (   ).      
+    //  ,    -     ,  ,  
+    // ,   .    ,     
+    // budget (       ),    .
+    CompactionReport compact(size_t budget) {
+        if (!passActive) {
+            pass = CompactionReport();
+            pass.fragmentationBefore = fragmentation();
+            last = Handle();
+            passActive = true;
+        }
+        ++pass.steps;
+
+        //          : , 
+        //      ,    
+        size_t work = 0;
+        while (work < budget) {
+            Handle next = handleAt(manager.nextAllocated(last ? slots[last.index].address : nullptr));
+            if (!next) {
+                passActive = false;
+                pass.passFinished = true;
+                pass.fragmentationAfter = fragmentation();
+                break;
+            }
+            Slot& slot = slots[next.index];
+            if (!slot.pins) {
+                if (work && work + slot.size + kPrefix > budget)
+                    break; //     ,    
+                void* address = manager.slideDown(slot.address);
+                if (address != slot.address) {
+                    slot.address = address;
+                    pass.bytesMoved += slot.size + kPrefix;
+                    ++pass.blocksMoved;
+                    work += slot.size + kPrefix;
+                }
+            }
+            work += kVisitCost;
+            last = next;
+        }
+        return pass;
+    }
+
+    double fragmentation() const {
+        size_t free = manager.freeBytes();
+        return free ? 1.0 - static_cast<double>(manager.largestFreeBlock()) / static_cast<double>(free) : 0.0;
+    }
+
+    size_t live() const { return liveBlocks; }
+    Manager& underlying() { return manager; }
+    const Manager& underlying() const { return manager; }
+
+private:
+    Slot* find(Handle handle) {
+        if (!handle || handle.index >= slots.size())
+            return nullptr;
+        Slot& slot = slots[handle.index];
+        return slot.address && slot.generation == handle.generation ? &slot : nullptr;
+    }
+
+    const Slot* find(Handle handle) const {
+        return const_cast<HandleHeap*>(this)->find(handle);
+    }
+
+    //      :      
+    Handle handleAt(void* address) const {
+        if (!address)
+            return Handle();
+        uint32_t index = *static_cast<const uint32_t*>(address);
+        return Handle{ index, slots[index].generation };
+    }
+};
+
+} // namespace Relocatable
@@ -0,0 +1,149 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <cstring>
+#include <cassert>
+#include <cstdint>
+#include "Relocatable.h"
+#include "BoundaryTagManager.h"
+#include "SortedListManager.h"
+
+using Relocatable::Handle;
+
+//   -   ,    ,    
+template <class Heap>
+void fill(Heap& heap, Handle handle) {
+    std::memset(heap.get(handle), static_cast<int>(handle.index & 0xFF), heap.size(handle));
+}
+
+template <class Heap>
+bool intact(const Heap& heap, Handle handle) {
+    const unsigned char* data = static_cast<const unsigned char*>(heap.get(handle));
+    for (size_t i = 0; i < heap.size(handle); ++i) {
+        if (data[i] != (handle.index & 0xFF))
+            return false;
+    }
+    return true;
+}
+
+//   :    32-2048 ,   
+// .   ,    ,     .
+//      budget ,     .
+template <class Manager>
+void run(const char* label, size_t poolSize, size_t budget) {
+    using Clock = std::chrono::steady_clock;
+    Relocatable::HandleHeap<Manager> heap(poolSize);
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<size_t> sizeDist(32, 2048);
+
+    std::vector<Handle> live;
+    for (;;) {
+        Handle handle = heap.allocate(sizeDist(rng));
+        if (!handle)
+            break;
+        fill(heap, handle);
+        live.push_back(handle);
+    }
+    for (size_t i = 0; i < live.size(); ) {
+        if (rng() % 2) {
+            heap.deallocate(live[i]);
+            live[i] = live.back();
+            live.pop_back();
+        }
+        else {
+            ++i;
+        }
+    }
+    //     
+    Handle pinned = live[live.size() / 2];
+    void* pinnedAddress = heap.get(pinned);
+    heap.pin(pinned);
+
+    size_t large = poolSize / 4;
+    size_t largestBefore = heap.underlying().largestFreeBlock();
+    Handle early = heap.allocate(large);
+    bool failedBefore = !early;
+    heap.deallocate(early);
+
+    Relocatable::CompactionReport report;
+    std::vector<double> slices;
+    while (!report.passFinished) {
+        auto start = Clock::now();
+        report = heap.compact(budget);
+        slices.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+
+        //   :    
+        for (int k = 0; k < 4 && !live.empty(); ++k) {
+            size_t victim = rng() % live.size();
+            if (live[victim] == pinned)
+                continue;
+            heap.deallocate(live[victim]);
+            live[victim] = heap.allocate(sizeDist(rng));
+            if (live[victim])
+                fill(heap, live[victim]);
+            else {
+                live[victim] = live.back();
+                live.pop_back();
+            }
+        }
+    }
+    size_t largestAfter = heap.underlying().largestFreeBlock();
+    Handle big = heap.allocate(large);
+
+    for (Handle handle : live)
+        assert(intact(heap, handle));
+    assert(heap.get(pinned) == pinnedAddress);
+    heap.unpin(pinned);
+
+    //      ,     
+    double longestMiddle = 0;
+    for (size_t i = 1; i + 1 < slices.size(); ++i)
+        longestMiddle = std::max(longestMiddle, slices[i]);
+    std::cout << std::left << std::setw(16) << label << std::right << std::fixed << std::setprecision(3)
+              << std::setw(10) << report.fragmentationBefore << std::setw(10) << report.fragmentationAfter
+              << std::setw(12) << largestBefore / 1024 << std::setw(12) << largestAfter / 1024
+              << std::setw(12) << report.bytesMoved / 1024 << std::setw(8) << report.steps << std::setprecision(1)
+              << std::setw(10) << std::max(slices.front(), slices.back()) << std::setw(10) << longestMiddle
+              << std::setw(8) << (failedBefore ? "no" : "yes") << std::setw(7) << (big ? "yes" : "no") << std::endl;
+}
+
+int main() {
+    //    ,     
+    Relocatable::HandleHeap<BoundaryTags::MemoryManager<>> heap(1024 * 1024);
+    Handle first = heap.allocate(100);
+    Handle second = heap.allocate(200);
+    std::memcpy(heap.get(second), "moved", 6);
+    heap.deallocate(first);
+    while (!heap.compact(1024).passFinished) {}
+    assert(std::strcmp(static_cast<char*>(heap.get(second)), "moved") == 0);
+    assert(heap.get(first) == nullptr && heap.fragmentation() == 0.0 && heap.underlying().isConsistent());
+    {
+        Relocatable::HandleHeap<BoundaryTags::MemoryManager<>>::Pin pin(heap, second);
+        assert(pin.get() == heap.get(second));
+    }
+    //     :       
+    Handle third = heap.allocate(300);
+    void* thirdAddress = heap.get(third);
+    heap.unpin(third);
+    heap.deallocate(second);
+    while (!heap.compact(1024).passFinished) {}
+    assert(heap.get(third) != thirdAddress && heap.fragmentation() == 0.0);
+    heap.deallocate(third);
+
+    //        size_t -  ,      
+    assert(!heap.allocate(SIZE_MAX - 8) && heap.underlying().isConsistent());
+
+    const size_t poolSize = 64 * 1024 * 1024;
+    const size_t budget = 256 * 1024;
+    std::cout << "pool " << poolSize / (1024 * 1024) << "MB, step budget " << budget / 1024 << "KB" << std::endl;
+    std::cout << std::left << std::setw(16) << "manager" << std::right << std::setw(10) << "frag" << std::setw(10) << "frag'"
+              << std::setw(12) << "largest KB" << std::setw(12) << "largest' KB" << std::setw(12) << "moved KB"
+              << std::setw(8) << "steps" << std::setw(10) << "ends us" << std::setw(10) << "max us" << std::setw(8) << "big" << std::setw(7) << "big'" << std::endl;
+    run<BoundaryTags::MemoryManager<>>("boundary tags", poolSize, budget);
+    run<SortedList::MemoryManager<SortedList::FirstFit>>("list/first", poolSize, budget);
+    run<SortedList::MemoryManager<SortedList::IndexedBestFit>>("list/best-idx", poolSize, budget);
+    return 0;
+}
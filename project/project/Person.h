@@ -0,0 +1,196 @@
+//Person :    -   .   23         ,  -    .
+//getName() :   std::string_view  .
+//setName(std::string_view name) :     -    .
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+class Person final
+{
+public:
+	static constexpr size_t kInlineCapacity = 23; //    
+
+	Person() noexcept : age{ 0 }, length{ 0 } { storage.local[0] = '\0'; }
+
+	Person(unsigned age, std::string_view name) : age{ age }, length{ 0 }
+	{
+		storage.local[0] = '\0';
+		assign(name);
+	}
+
+	Person(const Person& other) : Person(other.age, other.getName()) {}
+
+	//        24  
+	Person(Person&& other) noexcept : storage(other.storage), age{ other.age }, length{ other.length }
+	{
+		other.reset();
+	}
+
+	Person& operator =(const Person& other)
+	{
+		if (this != &other)
+		{
+			age = other.age;
+			assign(other.getName());
+		}
+		return *this;
+	}
+
+	Person& operator =(Person&& other) noexcept
+	{
+		if (this != &other)
+		{
+			release();
+			storage = other.storage;
+			age = other.age;
+			length = other.length;
+			other.reset();
+		}
+		return *this;
+	}
+
+	~Person() { release(); }
+
+	unsigned getAge() const { return age; }
+	std::string_view getName() const { return { data(), length }; }
+
+	void setAge(unsigned personAge) { age = personAge; }
+	void setName(std::string_view personName) { assign(personName); }
+
+	friend std::ostream& operator <<(std::ostream& os, const Person& person)
+	{
+		return os << person.getAge() << " " << person.getName();
+	}
+
+	//  ,     ,  
+	friend std::istream& operator >>(std::istream& is, Person& person)
+	{
+		unsigned age;
+		std::string name;
+		if (is >> age >> name)
+		{
+			person.setAge(age);
+			person.setName(name);
+		}
+		return is;
+	}
+
+	Person& operator +=(const Person& right)
+	{
+		age += right.age;
+		return *this;
+	}
+
+	Person operator+(Person right) const
+	{
+		return right += *this;
+	}
+
+	Person& operator++()
+	{
+		age++;
+		return *this;
+	}
+
+	Person operator++(int)
+	{
+		Person temp = *this;
+		++*this;
+		return temp;
+	}
+
+	bool operator <(const Person& right) const
+	{
+		return age < right.age;
+	}
+
+	bool operator >(const Person& right) const
+	{
+		return age > right.age;
+	}
+
+	bool operator ==(const Person& right) const
+	{
+		return age == right.age;
+	}
+
+	bool operator !=(const Person& right) const
+	{
+		return !(*this == right);
+	}
+
+private:
+	//  :      
+	struct HeapName
+	{
+		char* data;
+		size_t capacity;
+	};
+
+	//        ;    ,  length
+	union Storage
+	{
+		char local[kInlineCapacity + 1];
+		HeapName heap;
+	};
+
+	bool isLocal() const { return length <= kInlineCapacity; }
+	const char* data() const { return isLocal() ? storage.local : storage.heap.data; }
+
+	//     :  -  ,  -  
+	// ,    ,   .     
+	//  ,       .
+	void assign(std::string_view name)
+	{
+		size_t size = name.size();
+		if (size > UINT32_MAX)
+			throw std::length_error("Person name is too long");
+		if (size <= kInlineCapacity)
+		{
+			char local[kInlineCapacity + 1];
+			std::memcpy(local, name.data(), size);
+			release();
+			std::memcpy(storage.local, local, size);
+			storage.local[size] = '\0';
+		}
+		else if (isLocal() || storage.heap.capacity < size)
+		{
+			char* buffer = new char[size + 1];
+			std::memcpy(buffer, name.data(), size);
+			buffer[size] = '\0';
+			release();
+			storage.heap.data = buffer;
+			storage.heap.capacity = size;
+		}
+		else
+		{
+			std::memmove(storage.heap.data, name.data(), size);
+			storage.heap.data[size] = '\0';
+		}
+		length = static_cast<uint32_t>(size);
+	}
+
+	void release()
+	{
+		if (!isLocal())
+			delete[] storage.heap.data;
+		length = 0;
+	}
+
+	void reset()
+	{
+		length = 0;
+		storage.local[0] = '\0';
+	}
+
+	//      : 24 + 4 + 4 = 32    
+	// (std::string  unsigned  32 + 4    4   )
+	Storage storage;
+	unsigned age;
+	uint32_t length; //  ;  kInlineCapacity    storage.local
+};
@@ -0,0 +1,296 @@
+//PersonIO::MappedFile : ,       (mmap / MapViewOfFile).           .
+//PersonIO::parseText(const char* begin, const char* end, Visit visit) :   " " (  operator<<,  -  ,   operator>>)  std::from_chars; visit(age, name)    string_view   .
+//PersonIO::TextWriter :   " \n"  std::to_chars   ,    .
+//PersonIO::BinaryWriter / BinaryView :  :  "PRSN"  ,   [ u32][  u32][ ]  , little-endian. BinaryView      ,  - string_view  .
+//PersonIO::readText(path) / readBinary(path) :     PersonTable.
+#pragma once
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Person.h"
+#include "PersonTable.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace PersonIO {
+
+class MappedFile final
+{
+public:
+	explicit MappedFile(const std::string& path) : base(nullptr), length(0)
+	{
+#ifdef _WIN32
+		HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			throw std::runtime_error("cannot open " + path);
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size))
+		{
+			CloseHandle(file);
+			throw std::runtime_error("cannot stat " + path);
+		}
+		length = static_cast<size_t>(size.QuadPart);
+		if (length)
+		{
+			HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (mapping)
+			{
+				base = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+				CloseHandle(mapping); //    
+			}
+		}
+		CloseHandle(file);
+#else
+		int file = open(path.c_str(), O_RDONLY);
+		if (file < 0)
+			throw std::runtime_error("cannot open " + path);
+		struct stat info;
+		if (fstat(file, &info) != 0)
+		{
+			close(file);
+			throw std::runtime_error("cannot stat " + path);
+		}
+		length = static_cast<size_t>(info.st_size);
+		if (length)
+		{
+			void* address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, file, 0);
+			if (address != MAP_FAILED)
+			{
+				base = static_cast<const char*>(address);
+				madvise(address, length, MADV_SEQUENTIAL); //     
+			}
+		}
+		close(file);
+#endif
+		if (length && !base)
+			throw std::runtime_error("cannot map " + path);
+	}
+
+	~MappedFile()
+	{
+		if (!base)
+			return;
+#ifdef _WIN32
+		UnmapViewOfFile(base);
+#else
+		munmap(const_cast<char*>(base), length);
+#endif
+	}
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator =(const MappedFile&) = delete;
+
+	const char* data() const { return base; }
+	size_t size() const { return length; }
+
+private:
+	const char* base;
+	size_t length;
+};
+
+//    ,   operator>>
+inline bool isSpace(char c)
+{
+	return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+//   " ",    .   .
+//   - std::runtime_error      .
+template <class Visit>
+size_t parseText(const char* begin, const char* end, Visit visit)
+{
+	size_t records = 0;
+	const char* p = begin;
+	for (;;)
+	{
+		while (p != end && isSpace(*p))
+			++p;
+		if (p == end)
+			return records;
+
+		const char* record = p;
+		unsigned age;
+		std::from_chars_result parsed = std::from_chars(p, end, age);
+		if (parsed.ec != std::errc() || parsed.ptr == end || !isSpace(*parsed.ptr))
+			throw std::runtime_error("malformed Person age at byte " + std::to_string(record - begin));
+		p = parsed.ptr;
+		while (p != end && isSpace(*p))
+			++p;
+
+		const char* name = p;
+		while (p != end && !isSpace(*p))
+			++p;
+		if (p == name)
+			throw std::runtime_error("missing Person name at byte " + std::to_string(record - begin));
+		visit(age, std::string_view(name, static_cast<size_t>(p - name)));
+		++records;
+	}
+}
+
+//    :   write  kBufferSize 
+class TextWriter final
+{
+public:
+	explicit TextWriter(std::ostream& os) : os(os) { buffer.reserve(kBufferSize + 64); }
+	~TextWriter() { flush(); }
+
+	TextWriter(const TextWriter&) = delete;
+	TextWriter& operator =(const TextWriter&) = delete;
+
+	void write(unsigned age, std::string_view name)
+	{
+		char digits[16];
+		char* last = std::to_chars(digits, digits + sizeof(digits), age).ptr;
+		buffer.insert(buffer.end(), digits, last);
+		buffer.push_back(' ');
+		buffer.insert(buffer.end(), name.begin(), name.end());
+		buffer.push_back('\n');
+		if (buffer.size() >= kBufferSize)
+			flush();
+	}
+
+	void write(const Person& person) { write(person.getAge(), person.getName()); }
+
+	void flush()
+	{
+		os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+		buffer.clear();
+	}
+
+private:
+	static const size_t kBufferSize = 1 << 16;
+
+	std::ostream& os;
+	std::vector<char> buffer;
+};
+
+static const char kMagic[4] = { 'P', 'R', 'S', 'N' };
+static const uint32_t kVersion = 1;
+static const size_t kHeaderSize = sizeof(kMagic) + sizeof(kVersion);
+
+class BinaryWriter final
+{
+public:
+	explicit BinaryWriter(std::ostream& os) : os(os)
+	{
+		buffer.reserve(kBufferSize + 64);
+		buffer.insert(buffer.end(), kMagic, kMagic + sizeof(kMagic));
+		append(kVersion);
+	}
+
+	~BinaryWriter() { flush(); }
+
+	BinaryWriter(const BinaryWriter&) = delete;
+	BinaryWriter& operator =(const BinaryWriter&) = delete;
+
+	void write(unsigned age, std::string_view name)
+	{
+		if (name.size() > UINT32_MAX)
+			throw std::length_error("Person name is too long");
+		append(static_cast<uint32_t>(age));
+		append(static_cast<uint32_t>(name.size()));
+		buffer.insert(buffer.end(), name.begin(), name.end());
+		if (buffer.size() >= kBufferSize)
+			flush();
+	}
+
+	void write(const Person& person) { write(person.getAge(), person.getName()); }
+
+	void flush()
+	{
+		os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+		buffer.clear();
+	}
+
+private:
+	static const size_t kBufferSize = 1 << 16;
+
+	//      :  little-endian,   x86/x64
+	void append(uint32_t value)
+	{
+		char bytes[sizeof(value)];
+		std::memcpy(bytes, &value, sizeof(value));
+		buffer.insert(buffer.end(), bytes, bytes + sizeof(bytes));
+	}
+
+	std::ostream& os;
+	std::vector<char> buffer;
+};
+
+//       ( MappedFile)  
+class BinaryView final
+{
+public:
+	BinaryView(const char* data, size_t size) : begin(data), end(data + size)
+	{
+		uint32_t version;
+		if (size < kHeaderSize || std::memcmp(data, kMagic, sizeof(kMagic)) != 0)
+			throw std::runtime_error("not a Person binary file");
+		std::memcpy(&version, data + sizeof(kMagic), sizeof(version));
+		if (version != kVersion)
+			throw std::runtime_error("unsupported Person binary version " + std::to_string(version));
+	}
+
+	// visit(age, name)   ; name    .   .
+	template <class Visit>
+	size_t forEach(Visit visit) const
+	{
+		size_t records = 0;
+		const char* p = begin + kHeaderSize;
+		while (p != end)
+		{
+			uint32_t age, length;
+			if (static_cast<size_t>(end - p) < 2 * sizeof(uint32_t))
+				throw std::runtime_error("truncated Person record at byte " + std::to_string(p - begin));
+			std::memcpy(&age, p, sizeof(age));
+			std::memcpy(&length, p + sizeof(age), sizeof(length));
+			p += 2 * sizeof(uint32_t);
+			if (static_cast<size_t>(end - p) < length)
+				throw std::runtime_error("truncated Person name at byte " + std::to_string(p - begin));
+			visit(static_cast<unsigned>(age), std::string_view(p, length));
+			p += length;
+			++records;
+		}
+		return records;
+	}
+
+private:
+	const char* begin;
+	const char* end;
+};
+
+inline PersonTable readText(const std::string& path)
+{
+	MappedFile file(path);
+	PersonTable table;
+	table.reserve(0, file.size()); //      
+	parseText(file.data(), file.data() + file.size(), [&](unsigned age, std::string_view name) { table.add(age, name); });
+	return table;
+}
+
+inline PersonTable readBinary(const std::string& path)
+{
+	MappedFile file(path);
+	PersonTable table;
+	table.reserve(0, file.size());
+	BinaryView(file.data(), file.size()).forEach([&](unsigned age, std::string_view name) { table.add(age, name); });
+	return table;
+}
+
+} // namespace PersonIO
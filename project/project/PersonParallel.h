@@ -0,0 +1,455 @@
+//Parallel::ThreadPool :     :      ,        ,         .
+//Parallel::TaskGroup :   fork-join. wait()  ,     ,    ,       .
+//Parallel::mergeSort(pool, records) :     operator<:   ,      .
+//Parallel::sampleSort(pool, records) :  :    ,     ,   . .
+//Parallel::reduce(pool, records) :    operator+ (  - operator+=,     ).
+//Parallel::groupByAge(pool, records, width) :      width:        ,   .
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include "Person.h"
+
+namespace Parallel {
+
+class ThreadPool final
+{
+public:
+	explicit ThreadPool(size_t threads = std::thread::hardware_concurrency()) : queues(std::max<size_t>(threads, 1)), queued(0), next(0), stopping(false)
+	{
+		// ,  ,   -  wait()  ,      
+		for (size_t i = 1; i < queues.size(); ++i)
+			workers.emplace_back([this, i] { work(i); });
+	}
+
+	~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(sleepMutex);
+			stopping = true;
+		}
+		wakeUp.notify_all();
+		for (std::thread& worker : workers)
+			worker.join();
+	}
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator =(const ThreadPool&) = delete;
+
+	size_t size() const { return queues.size(); }
+
+	//        (     )
+	void submit(std::function<void()> task)
+	{
+		size_t index = currentQueue();
+		if (index == kExternal)
+			index = next.fetch_add(1, std::memory_order_relaxed) % queues.size();
+		{
+			std::lock_guard<std::mutex> lock(queues[index].mutex);
+			queues[index].tasks.push_back(std::move(task));
+		}
+		queued.fetch_add(1, std::memory_order_release);
+		{
+			//    queued    sleepMutex -       
+			std::lock_guard<std::mutex> lock(sleepMutex);
+		}
+		wakeUp.notify_one();
+	}
+
+	//   :     ( ,    ),
+	//  -   (  ). false -   .
+	bool runOne()
+	{
+		size_t self = currentQueue();
+		size_t first = self == kExternal ? 0 : self;
+		std::function<void()> task;
+		for (size_t k = 0; k < queues.size() && !task; ++k)
+		{
+			Queue& queue = queues[(first + k) % queues.size()];
+			std::lock_guard<std::mutex> lock(queue.mutex);
+			if (queue.tasks.empty())
+				continue;
+			if (k == 0 && self != kExternal)
+			{
+				task = std::move(queue.tasks.back());
+				queue.tasks.pop_back();
+			}
+			else
+			{
+				task = std::move(queue.tasks.front());
+				queue.tasks.pop_front();
+			}
+		}
+		if (!task)
+			return false;
+		queued.fetch_sub(1, std::memory_order_relaxed);
+		task();
+		return true;
+	}
+
+private:
+	static const size_t kExternal = static_cast<size_t>(-1);
+
+	struct Queue
+	{
+		std::mutex mutex;
+		std::deque<std::function<void()>> tasks;
+	};
+
+	//   : 0 - ,  , 1..size()-1 -  
+	size_t currentQueue() const
+	{
+		if (owner == this)
+			return ownerIndex;
+		return creator == std::this_thread::get_id() ? 0 : kExternal;
+	}
+
+	void work(size_t index)
+	{
+		owner = this;
+		ownerIndex = index;
+		for (;;)
+		{
+			if (runOne())
+				continue;
+			std::unique_lock<std::mutex> lock(sleepMutex);
+			wakeUp.wait(lock, [this] { return stopping || queued.load(std::memory_order_acquire) > 0; });
+			if (stopping)
+				return;
+		}
+	}
+
+	std::vector<Queue> queues;
+	std::vector<std::thread> workers;
+	std::atomic<size_t> queued;   //    
+	std::atomic<size_t> next;     //      
+	std::mutex sleepMutex;
+	std::condition_variable wakeUp;
+	bool stopping;
+	std::thread::id creator = std::this_thread::get_id();
+
+	static inline thread_local const ThreadPool* owner = nullptr; // ,    
+	static inline thread_local size_t ownerIndex = 0;
+};
+
+class TaskGroup final
+{
+public:
+	explicit TaskGroup(ThreadPool& pool) : pool(pool), pending(0) {}
+	~TaskGroup() { wait(); }
+
+	TaskGroup(const TaskGroup&) = delete;
+	TaskGroup& operator =(const TaskGroup&) = delete;
+
+	template <class Task>
+	void spawn(Task task)
+	{
+		pending.fetch_add(1, std::memory_order_relaxed);
+		pool.submit([this, task]() mutable {
+			task();
+			pending.fetch_sub(1, std::memory_order_release);
+		});
+	}
+
+	void wait()
+	{
+		while (pending.load(std::memory_order_acquire) > 0)
+		{
+			if (!pool.runOne())
+				std::this_thread::yield();
+		}
+	}
+
+private:
+	ThreadPool& pool;
+	std::atomic<size_t> pending;
+};
+
+namespace Detail {
+
+static const size_t kSequentialSort = 1 << 14;  //    std::sort   
+static const size_t kSequentialMerge = 1 << 15; //   - std::merge   
+
+//   [a, aEnd)  [b, bEnd)  out.      
+// :       ,     .
+//          .
+template <class T>
+void merge(ThreadPool& pool, T* a, T* aEnd, T* b, T* bEnd, T* out)
+{
+	size_t left = static_cast<size_t>(aEnd - a);
+	size_t right = static_cast<size_t>(bEnd - b);
+	if (left + right <= kSequentialMerge)
+	{
+		std::merge(std::make_move_iterator(a), std::make_move_iterator(aEnd),
+			std::make_move_iterator(b), std::make_move_iterator(bEnd), out);
+		return;
+	}
+	T* aMid;
+	T* bMid;
+	if (left >= right)
+	{
+		aMid = a + left / 2;
+		bMid = std::lower_bound(b, bEnd, *aMid);
+	}
+	else
+	{
+		bMid = b + right / 2;
+		aMid = std::upper_bound(a, aEnd, *bMid);
+	}
+	T* outMid = out + (aMid - a) + (bMid - b);
+	TaskGroup group(pool);
+	group.spawn([&pool, a, aMid, b, bMid, out] { merge(pool, a, aMid, b, bMid, out); });
+	merge(pool, aMid, aEnd, bMid, bEnd, outMid);
+	group.wait();
+}
+
+//  [begin, end)  data;    data,  !intoBuffer, 
+//     buffer.         .
+template <class T>
+void mergeSort(ThreadPool& pool, T* data, T* buffer, size_t begin, size_t end, bool intoBuffer)
+{
+	if (end - begin <= kSequentialSort)
+	{
+		std::stable_sort(data + begin, data + end);
+		if (intoBuffer)
+			std::move(data + begin, data + end, buffer + begin);
+		return;
+	}
+	size_t middle = begin + (end - begin) / 2;
+	{
+		TaskGroup group(pool);
+		group.spawn([&pool, data, buffer, begin, middle, intoBuffer] { mergeSort(pool, data, buffer, begin, middle, !intoBuffer); });
+		mergeSort(pool, data, buffer, middle, end, !intoBuffer);
+		group.wait();
+	}
+	T* from = intoBuffer ? data : buffer;
+	T* to = intoBuffer ? buffer : data;
+	merge(pool, from + begin, from + middle, from + middle, from + end, to + begin);
+}
+
+//      n :    ,     
+inline size_t partsFor(ThreadPool& pool, size_t n)
+{
+	size_t parts = pool.size() * 4;
+	return std::max<size_t>(1, std::min(parts, n / 4096));
+}
+
+} // namespace Detail
+
+template <class T>
+void mergeSort(ThreadPool& pool, std::vector<T>& records)
+{
+	if (records.size() < 2)
+		return;
+	std::vector<T> buffer(records.size());
+	Detail::mergeSort(pool, records.data(), buffer.data(), 0, records.size(), false);
+}
+
+template <class T>
+void sampleSort(ThreadPool& pool, std::vector<T>& records)
+{
+	size_t n = records.size();
+	size_t parts = Detail::partsFor(pool, n);
+	if (n <= Detail::kSequentialSort || parts < 2)
+	{
+		std::sort(records.begin(), records.end());
+		return;
+	}
+
+	// :    16   ,  16-
+	const size_t oversampling = 16;
+	size_t buckets = parts;
+	std::mt19937_64 rng(n);
+	std::vector<T> sample;
+	sample.reserve(buckets * oversampling);
+	for (size_t i = 0; i < buckets * oversampling; ++i)
+		sample.push_back(records[rng() % n]);
+	std::sort(sample.begin(), sample.end());
+	std::vector<T> splitters;
+	for (size_t i = 1; i < buckets; ++i)
+		splitters.push_back(sample[i * oversampling]);
+
+	//  :       (, )
+	size_t chunk = (n + parts - 1) / parts;
+	std::vector<uint32_t> bucketOf(n);
+	std::vector<size_t> counts(parts * buckets, 0);
+	{
+		TaskGroup group(pool);
+		for (size_t part = 0; part < parts; ++part)
+		{
+			group.spawn([&, part] {
+				size_t* local = counts.data() + part * buckets;
+				for (size_t i = part * chunk; i < std::min(n, (part + 1) * chunk); ++i)
+				{
+					size_t bucket = static_cast<size_t>(std::upper_bound(splitters.begin(), splitters.end(), records[i]) - splitters.begin());
+					bucketOf[i] = static_cast<uint32_t>(bucket);
+					++local[bucket];
+				}
+			});
+		}
+	}
+
+	// :  ,   -   
+	std::vector<size_t> bucketBegin(buckets + 1, 0);
+	size_t position = 0;
+	for (size_t bucket = 0; bucket < buckets; ++bucket)
+	{
+		bucketBegin[bucket] = position;
+		for (size_t part = 0; part < parts; ++part)
+		{
+			size_t count = counts[part * buckets + bucket];
+			counts[part * buckets + bucket] = position;
+			position += count;
+		}
+	}
+	bucketBegin[buckets] = n;
+
+	//  :   ,   
+	std::vector<T> buffer(n);
+	{
+		TaskGroup group(pool);
+		for (size_t part = 0; part < parts; ++part)
+		{
+			group.spawn([&, part] {
+				size_t* offsets = counts.data() + part * buckets;
+				for (size_t i = part * chunk; i < std::min(n, (part + 1) * chunk); ++i)
+					buffer[offsets[bucketOf[i]]++] = std::move(records[i]);
+			});
+		}
+	}
+	{
+		TaskGroup group(pool);
+		for (size_t bucket = 0; bucket < buckets; ++bucket)
+		{
+			group.spawn([&, bucket] {
+				T* first = buffer.data() + bucketBegin[bucket];
+				T* last = buffer.data() + bucketBegin[bucket + 1];
+				std::sort(first, last);
+				std::move(first, last, records.data() + bucketBegin[bucket]);
+			});
+		}
+	}
+}
+
+//      a += b   :    
+//   2^32,  -  .     operator+=,   operator+
+//           ;   
+// operator+    ,     .
+inline Person reduce(ThreadPool& pool, const std::vector<Person>& records)
+{
+	if (records.empty())
+		return Person();
+	size_t n = records.size();
+	size_t parts = Detail::partsFor(pool, n);
+	size_t chunk = (n + parts - 1) / parts;
+	std::vector<Person> partial(parts);
+	{
+		TaskGroup group(pool);
+		for (size_t part = 0; part < parts; ++part)
+		{
+			group.spawn([&, part] {
+				size_t begin = part * chunk;
+				size_t end = std::min(n, begin + chunk);
+				if (begin >= end)
+					return;
+				Person sum = records[begin];
+				for (size_t i = begin + 1; i < end; ++i)
+					sum += records[i];
+				partial[part] = std::move(sum);
+			});
+		}
+	}
+	Person total = partial[0];
+	for (size_t part = 1; part < parts && part * chunk < n; ++part)
+		total = partial[part] + std::move(total);
+	return total;
+}
+
+//   :  g -     [g * width, (g + 1) * width).
+//  ,     ,  width    .
+struct AgeGroups
+{
+	unsigned width = 1;
+	std::vector<size_t> offsets; //    rows; offsets[groups] = rows.size()
+	std::vector<size_t> rows;    //  ,   
+
+	size_t groups() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+	size_t count(size_t group) const { return offsets[group + 1] - offsets[group]; }
+	const size_t* begin(size_t group) const { return rows.data() + offsets[group]; }
+	const size_t* end(size_t group) const { return rows.data() + offsets[group + 1]; }
+};
+
+inline AgeGroups groupByAge(ThreadPool& pool, const std::vector<Person>& records, unsigned width)
+{
+	AgeGroups result;
+	result.width = std::max(width, 1u);
+	size_t n = records.size();
+	size_t parts = Detail::partsFor(pool, n);
+	size_t chunk = (n + parts - 1) / parts;
+
+	//   -   
+	std::vector<unsigned> oldest(parts, 0);
+	{
+		TaskGroup group(pool);
+		for (size_t part = 0; part < parts; ++part)
+		{
+			group.spawn([&, part] {
+				for (size_t i = part * chunk; i < std::min(n, (part + 1) * chunk); ++i)
+					oldest[part] = std::max(oldest[part], records[i].getAge());
+			});
+		}
+	}
+	size_t groups = n ? *std::max_element(oldest.begin(), oldest.end()) / result.width + 1 : 0;
+
+	//   ,   (, )    
+	std::vector<size_t> counts(parts * groups, 0);
+	{
+		TaskGroup group(pool);
+		for (size_t part = 0; part < parts; ++part)
+		{
+			group.spawn([&, part] {
+				size_t* local = counts.data() + part * groups;
+				for (size_t i = part * chunk; i < std::min(n, (part + 1) * chunk); ++i)
+					++local[records[i].getAge() / result.width];
+			});
+		}
+	}
+	result.offsets.assign(groups + 1, 0);
+	size_t position = 0;
+	for (size_t g = 0; g < groups; ++g)
+	{
+		result.offsets[g] = position;
+		for (size_t part = 0; part < parts; ++part)
+		{
+			size_t count = counts[part * groups + g];
+			counts[part * groups + g] = position;
+			position += count;
+		}
+	}
+	result.offsets[groups] = n;
+	result.rows.resize(n);
+	{
+		TaskGroup group(pool);
+		for (size_t part = 0; part < parts; ++part)
+		{
+			group.spawn([&, part] {
+				size_t* offsets = counts.data() + part * groups;
+				for (size_t i = part * chunk; i < std::min(n, (part + 1) * chunk); ++i)
+					result.rows[offsets[records[i].getAge() / result.width]++] = i;
+			});
+		}
+	}
+	return result;
+}
+
+} // namespace Parallel
@@ -0,0 +1,285 @@
+//PersonTable :   Person  :     uint32_t,  -          .       .
+//count(minAge, maxAge) / filter(minAge, maxAge) :        [minAge, maxAge],   .
+//sumAges() :      64- .
+//sortByAge() :     ; ,    , .
+//operator++() / operator+=(const Person& right) : ++  +=     Person,     .
+// : AVX2 (8 )  __AVX2__,  SSE2 (4 )  x86/x64,   .
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "Person.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define PERSON_TABLE_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PERSON_TABLE_SSE2
+#endif
+
+class PersonTable final
+{
+public:
+	PersonTable() = default;
+
+	explicit PersonTable(const std::vector<Person>& people)
+	{
+		reserve(people.size(), 0);
+		for (const Person& person : people)
+			add(person.getAge(), person.getName());
+	}
+
+	void reserve(size_t rows, size_t nameBytes)
+	{
+		ages.reserve(rows);
+		nameOffsets.reserve(rows);
+		nameLengths.reserve(rows);
+		names.reserve(nameBytes);
+	}
+
+	void add(unsigned age, std::string_view name)
+	{
+		if (name.size() > UINT32_MAX)
+			throw std::length_error("Person name is too long");
+		ages.push_back(age);
+		nameOffsets.push_back(names.size());
+		nameLengths.push_back(static_cast<uint32_t>(name.size()));
+		names.insert(names.end(), name.begin(), name.end());
+	}
+
+	void add(const Person& person) { add(person.getAge(), person.getName()); }
+
+	size_t size() const { return ages.size(); }
+	unsigned age(size_t row) const { return ages[row]; }
+	std::string_view name(size_t row) const { return { names.data() + nameOffsets[row], nameLengths[row] }; }
+	Person row(size_t index) const { return Person(age(index), name(index)); }
+
+	std::vector<Person> toPersons() const
+	{
+		std::vector<Person> people;
+		people.reserve(size());
+		for (size_t i = 0; i < size(); ++i)
+			people.emplace_back(age(i), name(i));
+		return people;
+	}
+
+	//   minAge <= age <= maxAge.     :
+	// age - minAge <= maxAge - minAge
+	size_t count(unsigned minAge, unsigned maxAge) const
+	{
+		if (minAge > maxAge)
+			return 0;
+		size_t total = 0;
+		scan(minAge, maxAge, [&](size_t, unsigned mask) { total += popCount(mask); });
+		return total;
+	}
+
+	std::vector<size_t> filter(unsigned minAge, unsigned maxAge) const
+	{
+		std::vector<size_t> rows;
+		if (minAge > maxAge)
+			return rows;
+		scan(minAge, maxAge, [&](size_t base, unsigned mask) {
+			for (; mask; mask &= mask - 1)
+				rows.push_back(base + lowestBit(mask));
+		});
+		return rows;
+	}
+
+	uint64_t sumAges() const
+	{
+		const uint32_t* column = ages.data();
+		size_t n = ages.size();
+		size_t i = 0;
+		uint64_t total = 0;
+#if defined(PERSON_TABLE_AVX2)
+		__m256i sums = _mm256_setzero_si256();
+		for (; i + 8 <= n; i += 8)
+		{
+			__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(column + i));
+			sums = _mm256_add_epi64(sums, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(v)));
+			sums = _mm256_add_epi64(sums, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(v, 1)));
+		}
+		alignas(32) uint64_t lanes[4];
+		_mm256_store_si256(reinterpret_cast<__m256i*>(lanes), sums);
+		total = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#elif defined(PERSON_TABLE_SSE2)
+		const __m128i zero = _mm_setzero_si128();
+		__m128i sums = zero;
+		for (; i + 4 <= n; i += 4)
+		{
+			__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(column + i));
+			sums = _mm_add_epi64(sums, _mm_unpacklo_epi32(v, zero));
+			sums = _mm_add_epi64(sums, _mm_unpackhi_epi32(v, zero));
+		}
+		alignas(16) uint64_t lanes[2];
+		_mm_store_si128(reinterpret_cast<__m128i*>(lanes), sums);
+		total = lanes[0] + lanes[1];
+#endif
+		for (; i < n; ++i)
+			total += column[i];
+		return total;
+	}
+
+	//   LSD   .   (,  ),
+	//         ;    .
+	void sortByAge()
+	{
+		size_t n = size();
+		if (n < 2)
+			return;
+		std::vector<uint32_t> keys(ages), keysBuffer(n);
+		std::vector<size_t> order(n), orderBuffer(n);
+		for (size_t i = 0; i < n; ++i)
+			order[i] = i;
+
+		for (int shift = 0; shift < 32; shift += 8)
+		{
+			size_t counts[256] = {};
+			for (uint32_t key : keys)
+				++counts[(key >> shift) & 0xFF];
+			//      -    
+			if (counts[(keys[0] >> shift) & 0xFF] == n)
+				continue;
+			size_t position = 0;
+			for (size_t& c : counts)
+			{
+				size_t bucket = c;
+				c = position;
+				position += bucket;
+			}
+			for (size_t i = 0; i < n; ++i)
+			{
+				size_t target = counts[(keys[i] >> shift) & 0xFF]++;
+				keysBuffer[target] = keys[i];
+				orderBuffer[target] = order[i];
+			}
+			keys.swap(keysBuffer);
+			order.swap(orderBuffer);
+		}
+
+		std::vector<size_t> offsets(n);
+		std::vector<uint32_t> lengths(n);
+		for (size_t i = 0; i < n; ++i)
+		{
+			offsets[i] = nameOffsets[order[i]];
+			lengths[i] = nameLengths[order[i]];
+		}
+		ages.swap(keys);
+		nameOffsets.swap(offsets);
+		nameLengths.swap(lengths);
+	}
+
+	PersonTable& operator++()
+	{
+		parallelRows([this](size_t begin, size_t end) {
+			uint32_t* column = ages.data();
+			for (size_t i = begin; i < end; ++i)
+				++column[i];
+		});
+		return *this;
+	}
+
+	PersonTable& operator+=(const Person& right)
+	{
+		uint32_t delta = right.getAge();
+		parallelRows([this, delta](size_t begin, size_t end) {
+			uint32_t* column = ages.data();
+			for (size_t i = begin; i < end; ++i)
+				column[i] += delta;
+		});
+		return *this;
+	}
+
+private:
+	static const size_t kParallelRows = 1 << 16; //   -  :    
+
+	static size_t popCount(unsigned mask)
+	{
+		size_t bits = 0;
+		for (; mask; mask &= mask - 1)
+			++bits;
+		return bits;
+	}
+
+	static size_t lowestBit(unsigned mask)
+	{
+		size_t bit = 0;
+		while (!(mask & 1))
+		{
+			mask >>= 1;
+			++bit;
+		}
+		return bit;
+	}
+
+	//   : visit(   ,    )
+	template <class Visit>
+	void scan(unsigned minAge, unsigned maxAge, Visit visit) const
+	{
+		const uint32_t* column = ages.data();
+		size_t n = ages.size();
+		size_t i = 0;
+		uint32_t range = maxAge - minAge;
+#if defined(PERSON_TABLE_AVX2)
+		const __m256i low = _mm256_set1_epi32(static_cast<int>(minAge));
+		const __m256i width = _mm256_set1_epi32(static_cast<int>(range));
+		for (; i + 8 <= n; i += 8)
+		{
+			__m256i shifted = _mm256_sub_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(column + i)), low);
+			__m256i inside = _mm256_cmpeq_epi32(_mm256_min_epu32(shifted, width), shifted);
+			unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(inside)));
+			if (mask)
+				visit(i, mask);
+		}
+#elif defined(PERSON_TABLE_SSE2)
+		//    SSE2 -     0x80000000
+		const __m128i bias = _mm_set1_epi32(static_cast<int>(0x80000000u));
+		const __m128i low = _mm_set1_epi32(static_cast<int>(minAge));
+		const __m128i biasedWidth = _mm_xor_si128(_mm_set1_epi32(static_cast<int>(range)), bias);
+		for (; i + 4 <= n; i += 4)
+		{
+			__m128i shifted = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(column + i)), low);
+			__m128i outside = _mm_cmpgt_epi32(_mm_xor_si128(shifted, bias), biasedWidth);
+			unsigned mask = static_cast<unsigned>(~_mm_movemask_ps(_mm_castsi128_ps(outside))) & 0xF;
+			if (mask)
+				visit(i, mask);
+		}
+#endif
+		for (; i < n; ++i)
+		{
+			if (column[i] - minAge <= range)
+				visit(i, 1u);
+		}
+	}
+
+	//        ,     
+	template <class Apply>
+	void parallelRows(Apply apply)
+	{
+		size_t n = size();
+		size_t threads = std::thread::hardware_concurrency();
+		if (n < kParallelRows || threads < 2)
+		{
+			apply(size_t(0), n);
+			return;
+		}
+		std::vector<std::thread> workers;
+		size_t part = (n + threads - 1) / threads;
+		for (size_t begin = part; begin < n; begin += part)
+			workers.emplace_back(apply, begin, std::min(begin + part, n));
+		apply(size_t(0), std::min(part, n));
+		for (std::thread& worker : workers)
+			worker.join();
+	}
+
+	std::vector<uint32_t> ages;         //  
+	std::vector<size_t> nameOffsets;    //     
+	std::vector<uint32_t> nameLengths;  //   
+	std::vector<char> names;            //     
+};
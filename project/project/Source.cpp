@@ -1,11 +1,25 @@
 #include <iostream>
+#include <iomanip>
 #include <string>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <chrono>
+#include <fstream>
+#include <filesystem>
+#include <cstdlib>
+#include "Person.h"
+#include "PersonTable.h"
+#include "PersonIO.h"
+#include "PersonParallel.h"
 
-class Person final
+//  Person (std::string      ,     )
+//    
+class LegacyPerson final
 {
 public:
-	Person() = default;
-	Person(unsigned age, std::string name) : age{ age }, name{ name } {}
+	LegacyPerson() = default;
+	LegacyPerson(unsigned age, std::string name) : name{ name }, age{ age } {}
 
 	unsigned getAge() const { return age; }
 	std::string getName() const { return name; }
@@ -13,72 +27,279 @@ public:
 	void setAge(unsigned personAge) { age = personAge; }
 	void setName(std::string personName) { name = personName; }
 
-	friend std::ostream& operator <<(std::ostream& os,const Person person)
+	bool operator <(const LegacyPerson& right) const
 	{
-		return os << person.getAge() << " " << person.getName();
+		return age < right.age;
 	}
 
-	friend std::istream& operator >>(std::istream& is, Person person)
+private:
+	std::string name;
+	unsigned age;
+};
+
+//     :  ,    23 
+std::vector<std::string> makeNames(size_t count)
+{
+	std::mt19937 rng(17);
+	std::vector<std::string> names(count);
+	for (size_t i = 0; i < count; ++i)
 	{
-		unsigned age;
-		std::string name;
-		is >> age >> name;
-		person.setAge(age);
-		person.setName(name);
-		return is;
+		names[i] = "Person" + std::to_string(rng() % 1000000);
+		if (i % 10 == 0)
+			names[i] += "-with-a-long-family-name"; //  -  ,   operator>>
 	}
-	
-	Person& operator +=(const Person& right)
+	return names;
+}
+
+// ,      count ;    
+template <class Record>
+void run(const char* label, const std::vector<std::string>& names)
+{
+	using Clock = std::chrono::steady_clock;
+	auto ms = [](Clock::time_point from, Clock::time_point to) { return std::chrono::duration<double, std::milli>(to - from).count(); };
+
+	auto start = Clock::now();
+	std::vector<Record> records;
+	records.reserve(names.size());
+	for (size_t i = 0; i < names.size(); ++i)
+		records.emplace_back(static_cast<unsigned>(i * 7919 % 100), names[i]);
+	auto constructed = Clock::now();
+
+	std::vector<Record> copy = records;
+	auto copied = Clock::now();
+
+	std::sort(copy.begin(), copy.end());
+	auto sorted = Clock::now();
+
+	size_t nameBytes = 0;
+	for (const Record& record : copy)
+		nameBytes += record.getName().size();
+
+	std::cout << std::left << std::setw(14) << label << std::right << std::fixed << std::setprecision(1)
+		<< std::setw(8) << sizeof(Record) << std::setw(12) << ms(start, constructed) << std::setw(10) << ms(constructed, copied)
+		<< std::setw(10) << ms(copied, sorted) << std::setw(12) << nameBytes << std::endl;
+}
+
+//      Person     :   , ,
+//     ++  
+void runQueries(const std::vector<std::string>& names)
+{
+	using Clock = std::chrono::steady_clock;
+	auto ms = [](Clock::time_point from, Clock::time_point to) { return std::chrono::duration<double, std::milli>(to - from).count(); };
+
+	std::vector<Person> people;
+	people.reserve(names.size());
+	for (size_t i = 0; i < names.size(); ++i)
+		people.emplace_back(static_cast<unsigned>(i * 7919 % 100), names[i]);
+	PersonTable table(people);
+
+	auto start = Clock::now();
+	size_t adults = std::count_if(people.begin(), people.end(), [](const Person& p) { return p.getAge() >= 18 && p.getAge() <= 65; });
+	auto counted = Clock::now();
+	uint64_t total = 0;
+	for (const Person& person : people)
+		total += person.getAge();
+	auto summed = Clock::now();
+	std::stable_sort(people.begin(), people.end());
+	auto sorted = Clock::now();
+	for (Person& person : people)
+		++person;
+	auto incremented = Clock::now();
+
+	auto tableStart = Clock::now();
+	size_t tableAdults = table.count(18, 65);
+	auto tableCounted = Clock::now();
+	uint64_t tableTotal = table.sumAges();
+	auto tableSummed = Clock::now();
+	table.sortByAge();
+	auto tableSorted = Clock::now();
+	++table;
+	auto tableIncremented = Clock::now();
+
+	if (adults != tableAdults || total != tableTotal || people.front().getName() != table.name(0))
+		std::cout << "table and vector disagree" << std::endl;
+
+	std::cout << std::left << std::setw(14) << "layout" << std::right << std::setw(10) << "count" << std::setw(10) << "sum"
+		<< std::setw(10) << "sort" << std::setw(10) << "++" << "   ms" << std::endl;
+	std::cout << std::left << std::setw(14) << "Person[]" << std::right << std::fixed << std::setprecision(2)
+		<< std::setw(10) << ms(start, counted) << std::setw(10) << ms(counted, summed)
+		<< std::setw(10) << ms(summed, sorted) << std::setw(10) << ms(sorted, incremented) << std::endl;
+	std::cout << std::left << std::setw(14) << "PersonTable" << std::right
+		<< std::setw(10) << ms(tableStart, tableCounted) << std::setw(10) << ms(tableCounted, tableSummed)
+		<< std::setw(10) << ms(tableSummed, tableSorted) << std::setw(10) << ms(tableSorted, tableIncremented) << std::endl;
+}
+
+//    records : iostream-  PersonIO (  to_chars/from_chars
+//      ).          .
+void runSerialization(const std::vector<std::string>& names, size_t records)
+{
+	using Clock = std::chrono::steady_clock;
+	std::filesystem::path directory = std::filesystem::temp_directory_path();
+	std::string textPath = (directory / "persons.txt").string();
+	std::string binaryPath = (directory / "persons.bin").string();
+
+	auto report = [records](const char* label, Clock::time_point from, Clock::time_point to, const std::string& path)
 	{
-		age += right.age;
-		return *this;
-	}
+		double seconds = std::chrono::duration<double>(to - from).count();
+		std::cout << std::left << std::setw(26) << label << std::right << std::fixed << std::setprecision(2)
+			<< std::setw(12) << records / seconds / 1e6 << std::setw(12) << std::filesystem::file_size(path) / seconds / (1 << 20) << std::endl;
+	};
+	auto person = [&](size_t i) { return Person(static_cast<unsigned>(i * 7919 % 100), names[i % names.size()]); };
 
-	Person operator+(Person right) const
+	std::cout << std::left << std::setw(26) << "operation" << std::right << std::setw(12) << "Mrec/s" << std::setw(12) << "MB/s" << std::endl;
+	auto start = Clock::now();
 	{
-		return right += *this;
+		std::ofstream out(textPath, std::ios::binary);
+		for (size_t i = 0; i < records; ++i)
+			out << person(i) << '\n';
 	}
+	report("write text operator<<", start, Clock::now(), textPath);
 
-	Person& operator++()
+	start = Clock::now();
 	{
-		age++;
-		return *this;
+		std::ofstream out(textPath, std::ios::binary);
+		PersonIO::TextWriter writer(out);
+		for (size_t i = 0; i < records; ++i)
+			writer.write(person(i));
 	}
+	report("write text TextWriter", start, Clock::now(), textPath);
 
-	Person operator++(int)
+	start = Clock::now();
 	{
-		Person temp = *this;
-		++*this;
-		return temp;
+		std::ofstream out(binaryPath, std::ios::binary);
+		PersonIO::BinaryWriter writer(out);
+		for (size_t i = 0; i < records; ++i)
+			writer.write(person(i));
 	}
+	report("write binary", start, Clock::now(), binaryPath);
 
-	bool operator <(const Person& right) const
+	start = Clock::now();
+	size_t streamed = 0;
 	{
-		return age < right.age;
+		std::ifstream in(textPath, std::ios::binary);
+		Person record;
+		while (in >> record)
+			streamed += record.getAge();
 	}
+	report("read text operator>>", start, Clock::now(), textPath);
 
-	bool operator >(const Person& right) const
+	start = Clock::now();
+	size_t parsed = 0;
 	{
-		return age > right.age;
+		PersonIO::MappedFile file(textPath);
+		PersonIO::parseText(file.data(), file.data() + file.size(), [&](unsigned age, std::string_view) { parsed += age; });
 	}
+	report("read text from_chars+mmap", start, Clock::now(), textPath);
 
-	bool operator ==(const Person& right) const
+	start = Clock::now();
+	size_t viewed = 0;
 	{
-		return age == right.age;
+		PersonIO::MappedFile file(binaryPath);
+		PersonIO::BinaryView(file.data(), file.size()).forEach([&](unsigned age, std::string_view) { viewed += age; });
 	}
+	report("read binary zero-copy", start, Clock::now(), binaryPath);
+
+	//    ,         
+	start = Clock::now();
+	uint64_t textTotal = PersonIO::readText(textPath).sumAges();
+	report("load text to table", start, Clock::now(), textPath);
+
+	start = Clock::now();
+	PersonTable table = PersonIO::readBinary(binaryPath);
+	report("load binary to table", start, Clock::now(), binaryPath);
+
+	if (streamed != parsed || parsed != viewed || table.size() != records || table.sumAges() != viewed || textTotal != viewed)
+		std::cout << "readers disagree" << std::endl;
+	std::filesystem::remove(textPath);
+	std::filesystem::remove(binaryPath);
+}
+
+//    records   1, 2, 4 ...    :  
+//  ,     .  -      .
+//    std::stable_sort.  100000000    10GB  (, ,
+//    ).
+void runScaling(const std::vector<std::string>& names, size_t records)
+{
+	using Clock = std::chrono::steady_clock;
+	auto ms = [](Clock::time_point from, Clock::time_point to) { return std::chrono::duration<double, std::milli>(to - from).count(); };
+
+	std::vector<Person> people;
+	people.reserve(records);
+	for (size_t i = 0; i < records; ++i)
+		people.emplace_back(static_cast<unsigned>(i * 7919 % 100), names[i % names.size()]);
+	std::vector<Person> expected = people;
+	std::stable_sort(expected.begin(), expected.end());
+	unsigned expectedAge = 0;
+	for (const Person& person : people)
+		expectedAge += person.getAge();
+
+	std::vector<size_t> threadCounts;
+	size_t cores = std::max(1u, std::thread::hardware_concurrency());
+	for (size_t threads = 1; threads < cores; threads *= 2)
+		threadCounts.push_back(threads);
+	threadCounts.push_back(cores);
 
-	bool operator !=(const Person& right) const
+	std::cout << std::left << std::setw(10) << "threads" << std::right << std::setw(12) << "merge sort" << std::setw(13) << "sample sort"
+		<< std::setw(10) << "reduce" << std::setw(10) << "group" << std::setw(10) << "speedup" << "   ms" << std::endl;
+	double single = 0;
+	for (size_t threads : threadCounts)
 	{
-		return !(*this == right);
-	}
+		Parallel::ThreadPool pool(threads);
+		std::vector<Person> merged = people;
+		auto start = Clock::now();
+		Parallel::mergeSort(pool, merged);
+		auto mergeSorted = Clock::now();
+		bool stable = std::equal(merged.begin(), merged.end(), expected.begin(),
+			[](const Person& a, const Person& b) { return a.getAge() == b.getAge() && a.getName() == b.getName(); });
+		merged.clear();
+		merged.shrink_to_fit();
 
+		std::vector<Person> sampled = people;
+		auto sampleStart = Clock::now();
+		Parallel::sampleSort(pool, sampled);
+		auto sampleSorted = Clock::now();
+		bool ordered = std::equal(sampled.begin(), sampled.end(), expected.begin());
+		sampled.clear();
+		sampled.shrink_to_fit();
 
-private:
-	std::string name;
-	unsigned age;
-};
-	 
+		auto reduceStart = Clock::now();
+		Person total = Parallel::reduce(pool, people);
+		auto reduced = Clock::now();
+		Parallel::AgeGroups groups = Parallel::groupByAge(pool, people, 10);
+		auto grouped = Clock::now();
 
+		if (!stable || !ordered || total.getAge() != expectedAge || groups.rows.size() != records)
+			std::cout << "parallel results disagree" << std::endl;
+		if (threads == 1)
+			single = ms(start, mergeSorted);
+		std::cout << std::left << std::setw(10) << threads << std::right << std::fixed << std::setprecision(1)
+			<< std::setw(12) << ms(start, mergeSorted) << std::setw(13) << ms(sampleStart, sampleSorted)
+			<< std::setw(10) << ms(reduceStart, reduced) << std::setw(10) << ms(reduced, grouped)
+			<< std::setw(10) << std::setprecision(2) << single / ms(start, mergeSorted) << std::endl;
+	}
+}
 
+//  -      (100000000 -  2GB )   
+//   (  10000000)
+int main(int argc, char** argv)
+{
+	const size_t count = 1000000;
+	std::vector<std::string> names = makeNames(count);
 
+	std::cout << std::left << std::setw(14) << "record" << std::right << std::setw(8) << "bytes" << std::setw(12) << "construct"
+		<< std::setw(10) << "copy" << std::setw(10) << "sort" << std::setw(12) << "name bytes" << "   ms" << std::endl;
+	run<LegacyPerson>("std::string", names);
+	run<Person>("inline name", names);
+	std::cout << std::endl;
+	runQueries(names);
+	std::cout << std::endl;
+	runSerialization(names, argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 5 * count);
+	std::cout << std::endl;
+	runScaling(names, argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 10 * count);
+	std::cout << std::endl;
 
+	Person person(30, "Alice");
+	person.setName(person.getName().substr(0, 3));
+	std::cout << person << std::endl;
+	return 0;
+}